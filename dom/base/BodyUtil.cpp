@@ -10,6 +10,7 @@
 #include "nsString.h"
 #include "nsIGlobalObject.h"
 #include "mozilla/Encoding.h"
+#include "mozilla/TextUtils.h"
 #include "mozilla/dom/MimeType.h"
 #include "nsCRT.h"
 #include "nsCharSeparatedTokenizer.h"
@@ -448,13 +449,13 @@ nsresult BodyUtil::ConsumeText(uint32_t aInputLength, uint8_t* aInput,
   return NS_OK;
 }
 
-// static
-void BodyUtil::ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
-                           const nsString& aStr, ErrorResult& aRv) {
+template <typename CharT>
+static void ParseJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
+                      const CharT* aChars, uint32_t aLength, ErrorResult& aRv) {
   aRv.MightThrowJSException();
 
   JS::Rooted<JS::Value> json(aCx);
-  if (!JS_ParseJSON(aCx, aStr.get(), aStr.Length(), &json)) {
+  if (!JS_ParseJSON(aCx, aChars, aLength, &json)) {
     if (!JS_IsExceptionPending(aCx)) {
       aRv.Throw(NS_ERROR_DOM_UNKNOWN_ERR);
       return;
@@ -472,4 +473,34 @@ void BodyUtil::ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
   aValue.set(json);
 }
 
+// static
+void BodyUtil::ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
+                           const nsString& aStr, ErrorResult& aRv) {
+  ParseJson(aCx, aValue, aStr.get(), aStr.Length(), aRv);
+}
+
+// static
+void BodyUtil::ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
+                           uint32_t aInputLength, uint8_t* aInput,
+                           ErrorResult& aRv) {
+  // JSON bodies are very often pure ASCII, which is also valid Latin-1. Parse
+  // those in place rather than inflating them to UTF-16, which saves an
+  // allocation and a copy, and lets the JS engine create Latin-1 strings.
+  // (An ASCII body can't start with a UTF-8 BOM, so there's nothing to strip.)
+  if (IsAscii(Span(reinterpret_cast<const char*>(aInput), aInputLength))) {
+    ParseJson(aCx, aValue, reinterpret_cast<const JS::Latin1Char*>(aInput),
+              aInputLength, aRv);
+    return;
+  }
+
+  nsString decoded;
+  nsresult rv = ConsumeText(aInputLength, aInput, decoded);
+  if (NS_FAILED(rv)) {
+    aRv.Throw(rv);
+    return;
+  }
+
+  ConsumeJson(aCx, aValue, decoded, aRv);
+}
+
 }  // namespace mozilla::dom
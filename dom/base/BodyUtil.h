@@ -67,6 +67,15 @@ class BodyUtil final {
    */
   static void ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
                           const nsString& aStr, ErrorResult& aRv);
+
+  /**
+   * Parses the UTF-8 encoded body in |aInput| as JSON, assigning the result to
+   * |aValue|. ASCII bodies are parsed directly, without first decoding them to
+   * UTF-16. Sets |aRv| to a syntax error if the body contains invalid data.
+   */
+  static void ConsumeJson(JSContext* aCx, JS::MutableHandle<JS::Value> aValue,
+                          uint32_t aInputLength, uint8_t* aInput,
+                          ErrorResult& aRv);
 };
 
 }  // namespace dom
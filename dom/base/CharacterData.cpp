@@ -558,22 +558,9 @@ bool CharacterData::ThreadSafeTextIsOnlyWhitespace() const {
     return HasFlag(NS_TEXT_IS_ONLY_WHITESPACE);
   }
 
-  const char* cp = mText.Get1b();
-  const char* end = cp + mText.GetLength();
-
-  while (cp < end) {
-    char ch = *cp;
-
-    // NOTE(emilio): If you ever change the definition of "whitespace" here, you
-    // need to change it too in RestyleManager::CharacterDataChanged.
-    if (!dom::IsSpaceCharacter(ch)) {
-      return false;
-    }
-
-    ++cp;
-  }
-
-  return true;
+  // NOTE(emilio): If you ever change the definition of "whitespace" here, you
+  // need to change it too in RestyleManager::CharacterDataChanged.
+  return mText.Is1bOnlyWhitespace();
 }
 
 already_AddRefed<nsAtom> CharacterData::GetCurrentValueAtom() {
@@ -9,6 +9,7 @@
 
 #include "mozilla/DoublyLinkedList.h"
 #include "mozilla/Likely.h"
+#include "mozilla/TextUtils.h"
 #include "mozilla/UniquePtr.h"
 #include "nsCOMPtr.h"              // for member, local
 #include "nsGkAtoms.h"             // for nsGkAtoms::baseURIProperty
@@ -69,12 +70,10 @@ namespace dom {
  * https://infra.spec.whatwg.org/#ascii-whitespace
  */
 inline bool IsSpaceCharacter(char16_t aChar) {
-  return aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' ||
-         aChar == '\f';
+  return mozilla::IsAsciiWhitespace(aChar);
 }
 inline bool IsSpaceCharacter(char aChar) {
-  return aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' ||
-         aChar == '\f';
+  return mozilla::IsAsciiWhitespace(aChar);
 }
 class AbstractRange;
 class AccessibleNode;
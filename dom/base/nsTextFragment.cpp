@@ -18,6 +18,8 @@
 #include "mozilla/CheckedInt.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/SSE.h"
+#include "mozilla/TextUtils.h"
+#include "mozilla/arm.h"
 #include "mozilla/ppc.h"
 #include "nsTextFragmentImpl.h"
 #include <algorithm>
@@ -158,7 +160,7 @@ static inline int32_t FirstNon8BitUnvectorized(const char16_t* str,
   return -1;
 }
 
-#if defined(MOZILLA_MAY_SUPPORT_SSE2)
+#if defined(MOZILLA_MAY_SUPPORT_SSE2) || defined(MOZ_TEXTFRAGMENT_NEON)
 #  include "nsTextFragmentGenericFwd.h"
 #endif
 
@@ -179,9 +181,18 @@ int32_t FirstNon8Bit(const char16_t* str, const char16_t* end);
  */
 static inline int32_t FirstNon8Bit(const char16_t* str, const char16_t* end) {
 #ifdef MOZILLA_MAY_SUPPORT_SSE2
+#  ifdef MOZ_TEXTFRAGMENT_AVX2
+  if (mozilla::supports_avx2()) {
+    return mozilla::FirstNon8Bit<xsimd::avx2>(str, end);
+  }
+#  endif
   if (mozilla::supports_sse2()) {
     return mozilla::FirstNon8Bit<xsimd::sse2>(str, end);
   }
+#elif defined(MOZ_TEXTFRAGMENT_NEON)
+  if (mozilla::supports_neon()) {
+    return mozilla::FirstNon8Bit<xsimd::neon>(str, end);
+  }
 #elif defined(__powerpc__)
   if (mozilla::supports_vmx()) {
     return mozilla::VMX::FirstNon8Bit(str, end);
@@ -191,6 +202,65 @@ static inline int32_t FirstNon8Bit(const char16_t* str, const char16_t* end) {
   return FirstNon8BitUnvectorized(str, end);
 }
 
+/*
+ * This function returns true if all characters in str are ASCII whitespace, as
+ * defined by mozilla::IsAsciiWhitespace (and so dom::IsSpaceCharacter).
+ */
+static inline bool IsOnlySpaceCharacters(const char* str, const char* end) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+#  ifdef MOZ_TEXTFRAGMENT_AVX2
+  if (mozilla::supports_avx2()) {
+    return mozilla::IsOnlySpaceCharacters<xsimd::avx2>(str, end);
+  }
+#  endif
+  if (mozilla::supports_sse2()) {
+    return mozilla::IsOnlySpaceCharacters<xsimd::sse2>(str, end);
+  }
+#elif defined(MOZ_TEXTFRAGMENT_NEON)
+  if (mozilla::supports_neon()) {
+    return mozilla::IsOnlySpaceCharacters<xsimd::neon>(str, end);
+  }
+#endif
+
+  return std::all_of(str, end, mozilla::IsAsciiWhitespace<char>);
+}
+
+/*
+ * This function returns the number of '\n' characters in str.
+ */
+template <typename CharT>
+static inline uint32_t CountNewlines(const CharT* str, const CharT* end) {
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+#  ifdef MOZ_TEXTFRAGMENT_AVX2
+  if (mozilla::supports_avx2()) {
+    return mozilla::CountNewlines<xsimd::avx2>(str, end);
+  }
+#  endif
+  if (mozilla::supports_sse2()) {
+    return mozilla::CountNewlines<xsimd::sse2>(str, end);
+  }
+#elif defined(MOZ_TEXTFRAGMENT_NEON)
+  if (mozilla::supports_neon()) {
+    return mozilla::CountNewlines<xsimd::neon>(str, end);
+  }
+#endif
+
+  return static_cast<uint32_t>(std::count(str, end, CharT('\n')));
+}
+
+bool nsTextFragment::Is1bOnlyWhitespace() const {
+  MOZ_ASSERT(!Is2b());
+  return IsOnlySpaceCharacters(m1b, m1b + GetLength());
+}
+
+uint32_t nsTextFragment::CountNewlines(uint32_t aLength) const {
+  const uint32_t length = std::min(aLength, GetLength());
+  if (Is2b()) {
+    return ::CountNewlines(Get2b(), Get2b() + length);
+  }
+  return ::CountNewlines(m1b, m1b + length);
+}
+
 bool nsTextFragment::SetTo(const char16_t* aBuffer, uint32_t aLength,
                            bool aUpdateBidi, bool aForce2b) {
   if (MOZ_UNLIKELY(aLength > NS_MAX_TEXT_FRAGMENT_LENGTH)) {
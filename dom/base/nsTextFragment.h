@@ -84,6 +84,19 @@ class nsTextFragment final {
     return (const char*)m1b;
   }
 
+  /**
+   * Return true if this 1-byte fragment only contains ASCII whitespace. Must
+   * not be called on a 2-byte fragment.
+   */
+  bool Is1bOnlyWhitespace() const;
+
+  /**
+   * Return the number of '\n' characters in this fragment, or in its first
+   * aLength characters if that is shorter.
+   */
+  uint32_t CountNewlines() const { return CountNewlines(GetLength()); }
+  uint32_t CountNewlines(uint32_t aLength) const;
+
   /**
    * Get the length of the fragment. The length is the number of logical
    * characters, not the number of bytes to store the characters.
@@ -0,0 +1,13 @@
+/* -*- mode: c++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* this source code form is subject to the terms of the mozilla public
+ * license, v. 2.0. if a copy of the mpl was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "nsTextFragmentGeneric.h"
+
+namespace mozilla {
+template int32_t FirstNon8Bit<xsimd::avx2>(const char16_t*, const char16_t*);
+template bool IsOnlySpaceCharacters<xsimd::avx2>(const char*, const char*);
+template uint32_t CountNewlines<xsimd::avx2>(const char*, const char*);
+template uint32_t CountNewlines<xsimd::avx2>(const char16_t*, const char16_t*);
+}  // namespace mozilla
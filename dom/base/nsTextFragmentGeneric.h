@@ -9,9 +9,13 @@
 
 #include "nsTextFragmentGenericFwd.h"
 
+#include "mozilla/MathAlgorithms.h"
+#include "mozilla/TextUtils.h"
 #include "nscore.h"
 #include "nsTextFragmentImpl.h"
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 
 namespace mozilla {
 
@@ -60,6 +64,87 @@ int32_t FirstNon8Bit(const char16_t* str, const char16_t* end) {
   return -1;
 }
 
+// The characters accepted by IsAsciiWhitespace, which is also what
+// dom::IsSpaceCharacter uses, so that a batch can be compared against each.
+constexpr char kAsciiWhitespaceChars[] = {' ', '\t', '\n', '\r', '\f'};
+
+constexpr bool MatchesIsAsciiWhitespace() {
+  size_t count = 0;
+  for (int ch = 0; ch < 256; ch++) {
+    bool inList = false;
+    for (char space : kAsciiWhitespaceChars) {
+      inList = inList || ch == static_cast<unsigned char>(space);
+    }
+    if (inList != IsAsciiWhitespace(static_cast<unsigned char>(ch))) {
+      return false;
+    }
+    count += inList;
+  }
+  return count == std::size(kAsciiWhitespaceChars);
+}
+static_assert(MatchesIsAsciiWhitespace(),
+              "kAsciiWhitespaceChars must match IsAsciiWhitespace");
+
+// Returns true if every character in [str, end) is ASCII whitespace.
+template <class Arch>
+bool IsOnlySpaceCharacters(const char* str, const char* end) {
+  using Batch = xsimd::batch<int8_t, Arch>;
+  const size_t numCharsPerVector = Batch::size;
+  const size_t len = end - str;
+  size_t i = 0;
+
+  // Check one batch at a time. Text nodes are rarely aligned, so use unaligned
+  // loads rather than an alignment prologue.
+  const size_t vectWalkEnd = (len / numCharsPerVector) * numCharsPerVector;
+  for (; i < vectWalkEnd; i += numCharsPerVector) {
+    const auto vect =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + i));
+    auto isSpace = vect == Batch(int8_t(kAsciiWhitespaceChars[0]));
+    for (size_t j = 1; j < std::size(kAsciiWhitespaceChars); j++) {
+      isSpace = isSpace | (vect == Batch(int8_t(kAsciiWhitespaceChars[j])));
+    }
+    if (!xsimd::all(isSpace)) {
+      return false;
+    }
+  }
+
+  // Take care of the remainder one character at a time.
+  for (; i < len; i++) {
+    if (!IsAsciiWhitespace(str[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns the number of '\n' characters in [str, end).
+template <class Arch, typename CharT>
+uint32_t CountNewlines(const CharT* str, const CharT* end) {
+  using Element = std::conditional_t<sizeof(CharT) == 1, int8_t, int16_t>;
+  using Batch = xsimd::batch<Element, Arch>;
+  const size_t numCharsPerVector = Batch::size;
+  const size_t len = end - str;
+  size_t i = 0;
+  uint32_t count = 0;
+
+  // Count one batch at a time, using the comparison's bit mask.
+  const Batch lineFeed(static_cast<Element>('\n'));
+  const size_t vectWalkEnd = (len / numCharsPerVector) * numCharsPerVector;
+  for (; i < vectWalkEnd; i += numCharsPerVector) {
+    const auto vect =
+        Batch::load_unaligned(reinterpret_cast<const Element*>(str + i));
+    count += CountPopulation64((vect == lineFeed).mask());
+  }
+
+  // Take care of the remainder one character at a time.
+  for (; i < len; i++) {
+    count += str[i] == '\n';
+  }
+
+  return count;
+}
+
 }  // namespace mozilla
 
 #endif
@@ -15,6 +15,12 @@ namespace mozilla {
 template <class Arch>
 int32_t FirstNon8Bit(const char16_t* str, const char16_t* end);
 
+template <class Arch>
+bool IsOnlySpaceCharacters(const char* str, const char* end);
+
+template <class Arch, typename CharT>
+uint32_t CountNewlines(const CharT* str, const CharT* end);
+
 }  // namespace mozilla
 
 #endif
@@ -7,4 +7,7 @@
 
 namespace mozilla {
 template int32_t FirstNon8Bit<xsimd::sse2>(const char16_t*, const char16_t*);
+template bool IsOnlySpaceCharacters<xsimd::sse2>(const char*, const char*);
+template uint32_t CountNewlines<xsimd::sse2>(const char*, const char*);
+template uint32_t CountNewlines<xsimd::sse2>(const char16_t*, const char16_t*);
 }  // namespace mozilla
@@ -650,16 +650,7 @@ static uint32_t CountNewlinesInXPLength(const Text& aTextNode,
   // For automated tests, we should abort on debug build.
   MOZ_ASSERT(aXPLength == UINT32_MAX || aXPLength <= textFragment.GetLength(),
              "aXPLength is out-of-bounds");
-  const uint32_t length = std::min(aXPLength, textFragment.GetLength());
-  if (!length) {
-    return 0;
-  }
-  if (textFragment.Is2b()) {
-    nsDependentSubstring str(textFragment.Get2b(), length);
-    return CountNewlinesInXPLength(str);
-  }
-  nsDependentCSubstring str(textFragment.Get1b(), length);
-  return CountNewlinesInXPLength(str);
+  return textFragment.CountNewlines(aXPLength);
 }
 
 template <typename StringType>
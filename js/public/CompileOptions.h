@@ -837,6 +837,12 @@ class MOZ_STACK_CLASS JS_PUBLIC_API DecodeOptions final
 
     introducerFilename_ = options.introducerFilename();
   }
+
+  explicit DecodeOptions(const ReadOnlyDecodeOptions& options) {
+    copyPODOptionsFrom(options);
+
+    introducerFilename_ = options.introducerFilename();
+  }
 };
 
 class JS_PUBLIC_API OwningDecodeOptions final : public ReadOnlyDecodeOptions {
@@ -12,6 +12,8 @@
 #ifndef js_HelperThreadAPI_h
 #define js_HelperThreadAPI_h
 
+#include "mozilla/TimeStamp.h"  // mozilla::TimeStamp
+
 #include <stddef.h>  // size_t
 
 #include "jstypes.h"  // JS_PUBLIC_API
@@ -35,6 +37,21 @@ extern JS_PUBLIC_API void SetHelperThreadTaskCallback(
 // Function to call from external thread pool to run a helper thread task.
 extern JS_PUBLIC_API void RunHelperThreadTask();
 
+/**
+ * Set a callback that is called on the helper thread just before each task
+ * runs, with the name of the kind of task, the time it was queued and the time
+ * it started. This lets the embedding record how long tasks waited for a
+ * helper thread, for example as profiler markers.
+ *
+ * The callback is called with the helper thread lock held, so it must not call
+ * back into the JS engine.
+ */
+using HelperThreadTaskStartCallback = void (*)(const char* taskName,
+                                               mozilla::TimeStamp queued,
+                                               mozilla::TimeStamp started);
+extern JS_PUBLIC_API void SetHelperThreadTaskStartCallback(
+    HelperThreadTaskStartCallback callback);
+
 }  // namespace JS
 
 #endif  // js_HelperThreadAPI_h
@@ -39,6 +39,7 @@
 #include "vm/JSContext.h"
 #include "vm/JSFunction.h"
 #include "vm/JSObject.h"
+#include "vm/ParallelSort.h"
 #include "vm/PlainObject.h"  // js::PlainObject
 #include "vm/SelfHosting.h"
 #include "vm/Shape.h"
@@ -1710,6 +1711,17 @@ struct SortComparatorStrings {
   }
 };
 
+// Like SortComparatorStrings, but for strings which have already been made
+// linear. This doesn't need a JSContext and can't fail, so it can be used with
+// ParallelMergeSort.
+struct SortComparatorLinearStrings {
+  bool operator()(const Value& a, const Value& b, bool* lessOrEqualp) {
+    *lessOrEqualp = CompareStrings(&a.toString()->asLinear(),
+                                   &b.toString()->asLinear()) <= 0;
+    return true;
+  }
+};
+
 struct SortComparatorLexicographicInt32 {
   bool operator()(const Value& a, const Value& b, bool* lessOrEqualp) {
     return CompareLexicographicInt32(a, b, lessOrEqualp);
@@ -1746,6 +1758,32 @@ struct SortComparatorStringifiedElements {
   }
 };
 
+// Like SortComparatorStringifiedElements, but without interrupt checks so that
+// it can be used with ParallelMergeSort.
+struct SortComparatorStringifiedElementsNoInterrupt {
+  const StringBuffer& sb;
+
+  explicit SortComparatorStringifiedElementsNoInterrupt(const StringBuffer& sb)
+      : sb(sb) {}
+
+  bool operator()(const StringifiedElement& a, const StringifiedElement& b,
+                  bool* lessOrEqualp) {
+    size_t lenA = a.charsEnd - a.charsBegin;
+    size_t lenB = b.charsEnd - b.charsBegin;
+
+    int32_t result;
+    if (sb.isUnderlyingBufferLatin1()) {
+      result = CompareChars(sb.rawLatin1Begin() + a.charsBegin, lenA,
+                            sb.rawLatin1Begin() + b.charsBegin, lenB);
+    } else {
+      result = CompareChars(sb.rawTwoByteBegin() + a.charsBegin, lenA,
+                            sb.rawTwoByteBegin() + b.charsBegin, lenB);
+    }
+    *lessOrEqualp = (result <= 0);
+    return true;
+  }
+};
+
 struct NumericElement {
   double dv;
   size_t elementIndex;
@@ -1856,16 +1894,11 @@ static ComparatorMatchResult MatchNumericComparator(JSContext* cx,
   return Match_None;
 }
 
-template <typename K, typename C>
-static inline bool MergeSortByKey(K keys, size_t len, K scratch, C comparator,
-                                  MutableHandle<GCVector<Value>> vec) {
+template <typename K>
+static void ReorderByKeys(K keys, size_t len,
+                          MutableHandle<GCVector<Value>> vec) {
   MOZ_ASSERT(vec.length() >= len);
 
-  /* Sort keys. */
-  if (!MergeSort(keys, len, scratch, comparator)) {
-    return false;
-  }
-
   /*
    * Reorder vec by keys in-place, going element by element.  When an out-of-
    * place element is encountered, move that element to its proper position,
@@ -1898,10 +1931,37 @@ static inline bool MergeSortByKey(K keys, size_t len, K scratch, C comparator,
     // the assertion vacuous, so don't bother, even in debug builds.
     vec[i].set(tv);
   }
+}
+
+template <typename K, typename C>
+static inline bool MergeSortByKey(K keys, size_t len, K scratch, C comparator,
+                                  MutableHandle<GCVector<Value>> vec) {
+  MOZ_ASSERT(vec.length() >= len);
+
+  /* Sort keys. */
+  if (!MergeSort(keys, len, scratch, comparator)) {
+    return false;
+  }
 
+  ReorderByKeys(keys, len, vec);
   return true;
 }
 
+/*
+ * Like MergeSortByKey, but sorts large inputs on helper threads. |comparator|
+ * must be infallible and must not use the JSContext.
+ */
+template <typename K, typename C>
+static inline void ParallelMergeSortByKey(JSContext* cx, K keys, size_t len,
+                                          K scratch, C comparator,
+                                          MutableHandle<GCVector<Value>> vec) {
+  MOZ_ASSERT(vec.length() >= len);
+
+  MOZ_ALWAYS_TRUE(ParallelMergeSort(cx, keys, len, scratch, comparator));
+
+  ReorderByKeys(keys, len, vec);
+}
+
 /*
  * Sort Values as strings.
  *
@@ -1937,6 +1997,13 @@ static bool SortLexicographically(JSContext* cx,
   }
 
   /* Sort Values in vec alphabetically. */
+  if (len >= ParallelSortMinLength) {
+    ParallelMergeSortByKey(cx, strElements.begin(), len,
+                           strElements.begin() + len,
+                           SortComparatorStringifiedElementsNoInterrupt(sb),
+                           vec);
+    return true;
+  }
   return MergeSortByKey(strElements.begin(), len, strElements.begin() + len,
                         SortComparatorStringifiedElements(cx, sb), vec);
 }
@@ -1959,6 +2026,7 @@ static bool SortNumerically(JSContext* cx, MutableHandle<GCVector<Value>> vec,
   }
 
   /* Convert Values to numerics. */
+  bool hasNaN = false;
   for (size_t i = 0; i < len; i++) {
     if (!CheckForInterrupt(cx)) {
       return false;
@@ -1970,9 +2038,20 @@ static bool SortNumerically(JSContext* cx, MutableHandle<GCVector<Value>> vec,
     }
 
     numElements[i] = {dv, i};
+    hasNaN |= std::isnan(dv);
   }
 
-  /* Sort Values in vec numerically. */
+  /*
+   * Sort Values in vec numerically. NaN makes the comparator inconsistent, and
+   * the order we'd then produce depends on the exact sequence of comparisons,
+   * so only use the parallel sort when there are none.
+   */
+  if (len >= ParallelSortMinLength && !hasNaN) {
+    ParallelMergeSortByKey(cx, numElements.begin(), len,
+                           numElements.begin() + len,
+                           SortComparatorNumerics[comp], vec);
+    return true;
+  }
   return MergeSortByKey(numElements.begin(), len, numElements.begin() + len,
                         SortComparatorNumerics[comp], vec);
 }
@@ -2174,7 +2253,21 @@ static bool ArrayNativeSortImpl(JSContext* cx, Handle<JSObject*> obj,
        * Sort using the default comparator converting all elements to
        * strings.
        */
-      if (allStrings) {
+      if (allStrings && n >= ParallelSortMinLength) {
+        // Flatten all the strings up front so the comparisons can run off
+        // the main thread.
+        for (size_t i = 0; i < n; i++) {
+          if (!CheckForInterrupt(cx)) {
+            return false;
+          }
+          if (!vec[i].toString()->ensureLinear(cx)) {
+            return false;
+          }
+        }
+        MOZ_ALWAYS_TRUE(vec.resize(n * 2));
+        MOZ_ALWAYS_TRUE(ParallelMergeSort(cx, vec.begin(), n, vec.begin() + n,
+                                          SortComparatorLinearStrings()));
+      } else if (allStrings) {
         MOZ_ALWAYS_TRUE(vec.resize(n * 2));
         if (!MergeSort(vec.begin(), n, vec.begin() + n,
                        SortComparatorStrings(cx))) {
@@ -2182,10 +2275,8 @@ static bool ArrayNativeSortImpl(JSContext* cx, Handle<JSObject*> obj,
         }
       } else if (allInts) {
         MOZ_ALWAYS_TRUE(vec.resize(n * 2));
-        if (!MergeSort(vec.begin(), n, vec.begin() + n,
-                       SortComparatorLexicographicInt32())) {
-          return false;
-        }
+        MOZ_ALWAYS_TRUE(ParallelMergeSort(cx, vec.begin(), n, vec.begin() + n,
+                                          SortComparatorLexicographicInt32()));
       } else {
         if (!SortLexicographically(cx, &vec, n)) {
           return false;
@@ -2194,10 +2285,8 @@ static bool ArrayNativeSortImpl(JSContext* cx, Handle<JSObject*> obj,
     } else {
       if (allInts) {
         MOZ_ALWAYS_TRUE(vec.resize(n * 2));
-        if (!MergeSort(vec.begin(), n, vec.begin() + n,
-                       SortComparatorInt32s[comp])) {
-          return false;
-        }
+        MOZ_ALWAYS_TRUE(ParallelMergeSort(cx, vec.begin(), n, vec.begin() + n,
+                                          SortComparatorInt32s[comp]));
       } else {
         if (!SortNumerically(cx, &vec, n, comp)) {
           return false;
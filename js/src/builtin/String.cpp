@@ -2186,6 +2186,93 @@ static MOZ_ALWAYS_INLINE bool ReportErrorIfFirstArgIsRegExp(
   return true;
 }
 
+/*
+ * Like HasSubstringAt, but |text| may be a rope. If the compared range lies
+ * within a single leaf of the rope, compare against that leaf instead of
+ * flattening the whole rope. This is the common case for prefix and suffix
+ * checks on strings that are built up by concatenation.
+ */
+static bool StringHasSubstringAt(JSContext* cx, HandleString text,
+                                 Handle<JSLinearString*> pat, size_t start,
+                                 bool* result) {
+  MOZ_ASSERT(start + pat->length() <= text->length());
+
+  size_t patLen = pat->length();
+  size_t offset = start;
+  JSString* node = text;
+  while (node->isRope()) {
+    JSRope& rope = node->asRope();
+    size_t leftLen = rope.leftChild()->length();
+    if (offset + patLen <= leftLen) {
+      node = rope.leftChild();
+    } else if (offset >= leftLen) {
+      offset -= leftLen;
+      node = rope.rightChild();
+    } else {
+      // The range spans both children, so flatten the whole text.
+      JSLinearString* linear = text->ensureLinear(cx);
+      if (!linear) {
+        return false;
+      }
+      *result = HasSubstringAt(linear, pat, start);
+      return true;
+    }
+  }
+
+  *result = HasSubstringAt(&node->asLinear(), pat, offset);
+  return true;
+}
+
+/*
+ * Ropes shorter than this are flattened rather than searched in place by
+ * StringMatch below; flattening them is cheap and makes any later searches of
+ * the same string linear.
+ */
+static const size_t sRopeSearchMinLength = 1024;
+
+static bool ShouldSearchRopeInPlace(JSString* text) {
+  if (!text->isRope() || text->length() < sRopeSearchMinLength) {
+    return false;
+  }
+
+  // A rope whose children are both linear is flattened with two copies, so
+  // there is little to gain from searching it in place.
+  JSRope& rope = text->asRope();
+  return rope.leftChild()->isRope() || rope.rightChild()->isRope();
+}
+
+/*
+ * Like StringMatch, but |text| may be a rope. Long, deep ropes are searched
+ * leaf by leaf when possible (see RopeMatch) instead of being flattened.
+ *
+ * A miss has to look at the whole rope, so the rope is flattened afterwards:
+ * code that probes the same string repeatedly then pays for the leaf walk
+ * only once.
+ */
+static bool StringMatch(JSContext* cx, HandleString text,
+                        Handle<JSLinearString*> pat, uint32_t start,
+                        int32_t* match) {
+  if (start == 0 && ShouldSearchRopeInPlace(text)) {
+    int ropeMatch;
+    if (!RopeMatch(cx, &text->asRope(), pat, &ropeMatch)) {
+      return false;
+    }
+    if (ropeMatch == -1 && !text->ensureLinear(cx)) {
+      return false;
+    }
+    *match = ropeMatch;
+    return true;
+  }
+
+  JSLinearString* linear = text->ensureLinear(cx);
+  if (!linear) {
+    return false;
+  }
+
+  *match = StringMatch(linear, pat, start);
+  return true;
+}
+
 // ES2018 draft rev de77aaeffce115deaf948ed30c7dbe4c60983c0c
 // 21.1.3.7 String.prototype.includes ( searchString [ , position ] )
 bool js::str_includes(JSContext* cx, unsigned argc, Value* vp) {
@@ -2231,12 +2318,12 @@ bool js::str_includes(JSContext* cx, unsigned argc, Value* vp) {
   uint32_t start = std::min(pos, textLen);
 
   // Steps 9-10.
-  JSLinearString* text = str->ensureLinear(cx);
-  if (!text) {
+  int32_t match;
+  if (!StringMatch(cx, str, searchStr, start, &match)) {
     return false;
   }
 
-  args.rval().setBoolean(StringMatch(text, searchStr, start) != -1);
+  args.rval().setBoolean(match != -1);
   return true;
 }
 
@@ -2286,12 +2373,12 @@ bool js::str_indexOf(JSContext* cx, unsigned argc, Value* vp) {
   }
 
   // Steps 10 and 11
-  JSLinearString* text = str->ensureLinear(cx);
-  if (!text) {
+  int32_t match;
+  if (!StringMatch(cx, str, searchStr, start, &match)) {
     return false;
   }
 
-  args.rval().setInt32(StringMatch(text, searchStr, start));
+  args.rval().setInt32(match);
   return true;
 }
 
@@ -2302,18 +2389,12 @@ bool js::StringIndexOf(JSContext* cx, HandleString string,
     return true;
   }
 
-  JSLinearString* text = string->ensureLinear(cx);
-  if (!text) {
-    return false;
-  }
-
-  JSLinearString* searchStr = searchString->ensureLinear(cx);
+  Rooted<JSLinearString*> searchStr(cx, searchString->ensureLinear(cx));
   if (!searchStr) {
     return false;
   }
 
-  *result = StringMatch(text, searchStr, 0);
-  return true;
+  return StringMatch(cx, string, searchStr, 0, result);
 }
 
 template <typename TextChar, typename PatChar>
@@ -2499,12 +2580,12 @@ bool js::str_startsWith(JSContext* cx, unsigned argc, Value* vp) {
   }
 
   // Steps 11-12.
-  JSLinearString* text = str->ensureLinear(cx);
-  if (!text) {
+  bool result;
+  if (!StringHasSubstringAt(cx, str, searchStr, start, &result)) {
     return false;
   }
 
-  args.rval().setBoolean(HasSubstringAt(text, searchStr, start));
+  args.rval().setBoolean(result);
   return true;
 }
 
@@ -2515,18 +2596,12 @@ bool js::StringStartsWith(JSContext* cx, HandleString string,
     return true;
   }
 
-  JSLinearString* str = string->ensureLinear(cx);
-  if (!str) {
-    return false;
-  }
-
-  JSLinearString* searchStr = searchString->ensureLinear(cx);
+  Rooted<JSLinearString*> searchStr(cx, searchString->ensureLinear(cx));
   if (!searchStr) {
     return false;
   }
 
-  *result = HasSubstringAt(str, searchStr, 0);
-  return true;
+  return StringHasSubstringAt(cx, string, searchStr, 0, result);
 }
 
 // ES2018 draft rev de77aaeffce115deaf948ed30c7dbe4c60983c0c
@@ -2586,12 +2661,12 @@ bool js::str_endsWith(JSContext* cx, unsigned argc, Value* vp) {
   uint32_t start = end - searchLen;
 
   // Steps 12-13.
-  JSLinearString* text = str->ensureLinear(cx);
-  if (!text) {
+  bool result;
+  if (!StringHasSubstringAt(cx, str, searchStr, start, &result)) {
     return false;
   }
 
-  args.rval().setBoolean(HasSubstringAt(text, searchStr, start));
+  args.rval().setBoolean(result);
   return true;
 }
 
@@ -2602,20 +2677,14 @@ bool js::StringEndsWith(JSContext* cx, HandleString string,
     return true;
   }
 
-  JSLinearString* str = string->ensureLinear(cx);
-  if (!str) {
-    return false;
-  }
-
-  JSLinearString* searchStr = searchString->ensureLinear(cx);
+  Rooted<JSLinearString*> searchStr(cx, searchString->ensureLinear(cx));
   if (!searchStr) {
     return false;
   }
 
-  uint32_t start = str->length() - searchStr->length();
+  uint32_t start = string->length() - searchStr->length();
 
-  *result = HasSubstringAt(str, searchStr, start);
-  return true;
+  return StringHasSubstringAt(cx, string, searchStr, start, result);
 }
 
 template <typename CharT>
@@ -5611,6 +5611,67 @@ static bool HelperThreadCount(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool HelperThreadWaitTimes(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  bool reset = args.length() > 0 && ToBoolean(args[0]);
+
+  RootedObject result(cx, JS_NewPlainObject(cx));
+  if (!result) {
+    return false;
+  }
+
+  using TaskWaitStats = GlobalHelperThreadState::TaskWaitStats;
+  mozilla::EnumeratedArray<ThreadType, THREAD_TYPE_MAX, TaskWaitStats> stats;
+  if (!js::SupportDifferentialTesting()) {
+    // Timings would make the output differ between runs.
+    AutoLockHelperThreadState lock;
+    if (HelperThreadState().isInitialized(lock)) {
+      for (size_t i = 0; i < size_t(THREAD_TYPE_MAX); i++) {
+        ThreadType threadType = ThreadType(i);
+        stats[threadType] = HelperThreadState().taskWaitStats(threadType, lock);
+      }
+      if (reset) {
+        HelperThreadState().resetTaskWaitStats(lock);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < size_t(THREAD_TYPE_MAX); i++) {
+    ThreadType threadType = ThreadType(i);
+    const char* name = HelperThreadTypeName(threadType);
+    const TaskWaitStats& s = stats[threadType];
+    if (!name || !s.count) {
+      continue;
+    }
+
+    RootedObject obj(cx, JS_NewPlainObject(cx));
+    if (!obj) {
+      return false;
+    }
+
+    RootedValue value(cx, NumberValue(double(s.count)));
+    if (!JS_DefineProperty(cx, obj, "count", value, JSPROP_ENUMERATE)) {
+      return false;
+    }
+    value.setDouble(s.total.ToMilliseconds());
+    if (!JS_DefineProperty(cx, obj, "totalMs", value, JSPROP_ENUMERATE)) {
+      return false;
+    }
+    value.setDouble(s.max.ToMilliseconds());
+    if (!JS_DefineProperty(cx, obj, "maxMs", value, JSPROP_ENUMERATE)) {
+      return false;
+    }
+
+    if (!JS_DefineProperty(cx, result, name, obj, JSPROP_ENUMERATE)) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
 static bool EnableShapeConsistencyChecks(JSContext* cx, unsigned argc,
                                          Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
@@ -6849,6 +6910,46 @@ static bool GetStringRepresentation(JSContext* cx, unsigned argc, Value* vp) {
 
 #endif
 
+static bool GetRopeFlattenStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  if (!cx->ropeFlattenStats.ref()) {
+    args.rval().setUndefined();
+    return true;
+  }
+
+  RootedObject result(cx, JS_NewPlainObject(cx));
+  if (!result) {
+    return false;
+  }
+
+  const js::RopeFlattenStats& stats = *cx->ropeFlattenStats.ref();
+  if (!JS_DefineProperty(cx, result, "count", double(stats.count),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, result, "reusedBufferCount",
+                         double(stats.reusedBufferCount), JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, result, "bytesCopied", double(stats.bytesCopied),
+                         JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static bool EnableRopeFlattenStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  if (ToBoolean(args.get(0))) {
+    cx->ropeFlattenStats.ref().emplace();
+  } else {
+    cx->ropeFlattenStats.ref().reset();
+  }
+
+  args.rval().setUndefined();
+  return true;
+}
+
 static bool ParseCompileOptionsForModule(JSContext* cx,
                                          JS::CompileOptions& options,
                                          JS::Handle<JSObject*> opts,
@@ -9401,6 +9502,13 @@ JS_FOR_WASM_FEATURES(WASM_FEATURE)
 "helperThreadCount()",
 "  Returns the number of helper threads available for off-thread tasks."),
 
+    JS_FN_HELP("helperThreadWaitTimes", HelperThreadWaitTimes, 0, 0,
+"helperThreadWaitTimes([reset])",
+"  Returns an object describing how long helper thread tasks waited to start\n"
+"  after being queued, keyed by task type. Each entry has the number of tasks\n"
+"  run and the total and maximum wait in milliseconds. If |reset| is true the\n"
+"  statistics are cleared afterwards."),
+
     JS_FN_HELP("createShapeSnapshot", CreateShapeSnapshot, 1, 0,
 "createShapeSnapshot(obj)",
 "  Returns an object containing a shape snapshot for use with\n"
@@ -9516,6 +9624,19 @@ JS_FOR_WASM_FEATURES(WASM_FEATURE)
 
 #endif
 
+    JS_FN_HELP("ropeFlattenStats", GetRopeFlattenStats, 0, 0,
+"ropeFlattenStats()",
+"  Return an object describing the ropes flattened on this thread since the\n"
+"  last call to enableRopeFlattenStats(true): |count| ropes were flattened, of\n"
+"  which |reusedBufferCount| extended the leftmost leaf's buffer in place, and\n"
+"  |bytesCopied| bytes of characters were copied in total. Returns undefined\n"
+"  if the counters are not enabled."),
+
+    JS_FN_HELP("enableRopeFlattenStats", EnableRopeFlattenStats, 1, 0,
+"enableRopeFlattenStats(enabled)",
+"  Start counting rope flattens on this thread from zero, or stop counting\n"
+"  them if |enabled| is false."),
+
     JS_FN_HELP("allocationMarker", AllocationMarker, 0, 0,
 "allocationMarker([options])",
 "  Return a freshly allocated object whose [[Class]] name is\n"
@@ -25,6 +25,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <type_traits>
 #include <utility>
 
@@ -2076,6 +2077,143 @@ bool TokenStreamSpecific<Unit, AnyCharsAccess>::putIdentInCharBuffer(
   return true;
 }
 
+// Helpers for looking at a 64-bit word of code units (8 UTF-8 or 4 UTF-16) at
+// a time. Long comment and string literal bodies, identifiers and indentation
+// are common in large scripts, so the scanners below check a whole word at
+// once and only look at individual code units once a word might contain one
+// that ends the run.
+template <typename Unit>
+struct CodeUnitWord {
+  static_assert(sizeof(Unit) == 1 || sizeof(Unit) == 2);
+
+  static constexpr size_t UnitsPerWord = sizeof(uint64_t) / sizeof(Unit);
+
+  // |ones| has the lowest bit of each code unit set, |highs| the highest and
+  // |bit7s| bit 7. |nonAscii| has every bit set that can only be set in
+  // non-ASCII units.
+  static constexpr uint64_t ones =
+      sizeof(Unit) == 1 ? 0x0101010101010101 : 0x0001000100010001;
+  static constexpr uint64_t highs = ones << (sizeof(Unit) * 8 - 1);
+  static constexpr uint64_t bit7s = ones * 0x80;
+  static constexpr uint64_t nonAscii =
+      sizeof(Unit) == 1 ? highs : ones * 0xFF80;
+
+  static uint64_t load(const Unit* units) {
+    uint64_t word;
+    memcpy(&word, units, sizeof(word));
+    return word;
+  }
+
+  // Non-zero if any code unit in |word| equals |c|, given that every code unit
+  // in |word| is ASCII.
+  static uint64_t hasUnit(uint64_t word, char c) {
+    uint64_t x = word ^ (ones * uint8_t(c));
+    return (x - ones) & ~x & highs;
+  }
+
+  // Returns a word with bit 7 set in exactly those code units of |word| that
+  // are in [lo, hi], and every other bit clear, given that every code unit in
+  // |word| is ASCII. For a code unit c, 128 + hi - c has bit 7 set iff c <= hi,
+  // and c + 128 - lo has it set iff c >= lo. Neither can carry or borrow into
+  // the next code unit, so unlike hasUnit this is exact for every code unit.
+  static uint64_t unitsInRange(uint64_t word, char lo, char hi) {
+    MOZ_ASSERT(0 <= lo && lo <= hi);
+    return (ones * (128 + uint8_t(hi)) - word) &
+           (word + ones * (128 - uint8_t(lo))) & bit7s;
+  }
+};
+
+// Returns the number of code units at the start of [units, limit) that are
+// ASCII and are none of '\n', '\r', |stop1|, |stop2| or |stop3|: that is, code
+// units that the caller can consume without any special handling.
+template <typename Unit>
+static size_t CountPlainAsciiUnits(const Unit* units, const Unit* limit,
+                                   char stop1, char stop2, char stop3) {
+  using Word = CodeUnitWord<Unit>;
+
+  size_t length = PointerRangeSize(units, limit);
+  size_t i = 0;
+  for (; i + Word::UnitsPerWord <= length; i += Word::UnitsPerWord) {
+    uint64_t word = Word::load(units + i);
+    if ((word & Word::nonAscii) ||
+        (Word::hasUnit(word, '\n') | Word::hasUnit(word, '\r') |
+         Word::hasUnit(word, stop1) | Word::hasUnit(word, stop2) |
+         Word::hasUnit(word, stop3))) {
+      break;
+    }
+  }
+
+  for (; i < length; i++) {
+    char16_t c = CodeUnitValue(units[i]);
+    if (c >= 0x80 || c == '\n' || c == '\r' || c == char16_t(stop1) ||
+        c == char16_t(stop2) || c == char16_t(stop3)) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+// Returns the number of ASCII IdentifierPart code units, [$0-9A-Z_a-z], at the
+// start of [units, limit).
+template <typename Unit>
+static size_t CountAsciiIdentifierUnits(const Unit* units, const Unit* limit) {
+  using Word = CodeUnitWord<Unit>;
+
+  size_t length = PointerRangeSize(units, limit);
+  size_t i = 0;
+  for (; i + Word::UnitsPerWord <= length; i += Word::UnitsPerWord) {
+    uint64_t word = Word::load(units + i);
+    if (word & Word::nonAscii) {
+      break;
+    }
+    uint64_t identifierParts = Word::unitsInRange(word, 'a', 'z') |
+                               Word::unitsInRange(word, 'A', 'Z') |
+                               Word::unitsInRange(word, '0', '9') |
+                               Word::unitsInRange(word, '_', '_') |
+                               Word::unitsInRange(word, '$', '$');
+    if (identifierParts != Word::bit7s) {
+      break;
+    }
+  }
+
+  for (; i < length; i++) {
+    char16_t c = CodeUnitValue(units[i]);
+    if (c >= 0x80 || !unicode::IsIdentifierPart(c)) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+// Returns the number of ' ' and '\t' code units at the start of
+// [units, limit).
+template <typename Unit>
+static size_t CountAsciiSpaceUnits(const Unit* units, const Unit* limit) {
+  using Word = CodeUnitWord<Unit>;
+
+  size_t length = PointerRangeSize(units, limit);
+  size_t i = 0;
+  for (; i + Word::UnitsPerWord <= length; i += Word::UnitsPerWord) {
+    uint64_t word = Word::load(units + i);
+    if ((word & Word::nonAscii) ||
+        (Word::unitsInRange(word, ' ', ' ') |
+         Word::unitsInRange(word, '\t', '\t')) != Word::bit7s) {
+      break;
+    }
+  }
+
+  for (; i < length; i++) {
+    char16_t c = CodeUnitValue(units[i]);
+    if (c != ' ' && c != '\t') {
+      break;
+    }
+  }
+
+  return i;
+}
+
 template <typename Unit, class AnyCharsAccess>
 [[nodiscard]] bool TokenStreamSpecific<Unit, AnyCharsAccess>::identifierName(
     TokenStart start, const Unit* identStart, IdentifierEscapes escaping,
@@ -2089,6 +2227,11 @@ template <typename Unit, class AnyCharsAccess>
   // code points in the loop below.
   int32_t unit;
   while (true) {
+    // Consume a run of ASCII IdentifierPart code units in one go, then handle
+    // whatever follows it one code point at a time.
+    this->sourceUnits.skipCodeUnits(CountAsciiIdentifierUnits(
+        this->sourceUnits.addressOfNextCodeUnit(), this->sourceUnits.limit()));
+
     unit = peekCodeUnit();
     if (unit == EOF) {
       break;
@@ -2250,7 +2393,12 @@ static_assert(LastCharKind < (1 << (sizeof(firstCharKinds[0]) * 8)),
 
 template <>
 void SourceUnits<char16_t>::consumeRestOfSingleLineComment() {
-  while (MOZ_LIKELY(!atEnd())) {
+  while (true) {
+    ptr += CountPlainAsciiUnits(ptr, limit_, '\n', '\n', '\n');
+    if (atEnd()) {
+      return;
+    }
+
     char16_t unit = peekCodeUnit();
     if (IsLineTerminator(unit)) {
       return;
@@ -2262,7 +2410,12 @@ void SourceUnits<char16_t>::consumeRestOfSingleLineComment() {
 
 template <>
 void SourceUnits<Utf8Unit>::consumeRestOfSingleLineComment() {
-  while (MOZ_LIKELY(!atEnd())) {
+  while (true) {
+    ptr += CountPlainAsciiUnits(ptr, limit_, '\n', '\n', '\n');
+    if (atEnd()) {
+      return;
+    }
+
     const Utf8Unit unit = peekCodeUnit();
     if (IsSingleUnitLineTerminator(unit)) {
       return;
@@ -2733,9 +2886,12 @@ template <typename Unit, class AnyCharsAccess>
       return true;
     }
 
-    // Skip over non-EOL whitespace chars.
+    // Skip over non-EOL whitespace chars, consuming any run of spaces and
+    // tabs (indentation, typically) in one go.
     //
     if (c1kind == Space) {
+      this->sourceUnits.skipCodeUnits(CountAsciiSpaceUnits(
+          this->sourceUnits.addressOfNextCodeUnit(), this->sourceUnits.limit()));
       continue;
     }
 
@@ -3149,6 +3305,12 @@ template <typename Unit, class AnyCharsAccess>
           unsigned linenoBefore = anyChars.lineno;
 
           do {
+            // Skip any run of ASCII code units that can't end the comment, a
+            // line or begin a directive in one go.
+            this->sourceUnits.skipCodeUnits(CountPlainAsciiUnits(
+                this->sourceUnits.addressOfNextCodeUnit(),
+                this->sourceUnits.limit(), '*', '@', '#'));
+
             int32_t unit = getCodeUnit();
             if (unit == EOF) {
               error(JSMSG_UNTERMINATED_COMMENT);
@@ -3271,7 +3433,29 @@ bool TokenStreamSpecific<Unit, AnyCharsAccess>::getStringOrTemplateToken(
   // equivalents), \\, EOF.  Because we detect EOL sequences here and
   // put them back immediately, we can use getCodeUnit().
   int32_t unit;
-  while ((unit = getCodeUnit()) != untilChar) {
+  while (true) {
+    // Append any run of ASCII code units that stand for themselves in one go.
+    // Templates also stop at '$', which might begin a substitution.
+    const Unit* run = this->sourceUnits.addressOfNextCodeUnit();
+    size_t runLength =
+        CountPlainAsciiUnits(run, this->sourceUnits.limit(), untilChar, '\\',
+                             parsingTemplate ? '$' : untilChar);
+    if (runLength > 0) {
+      size_t bufferLength = this->charBuffer.length();
+      if (!this->charBuffer.growByUninitialized(runLength)) {
+        return false;
+      }
+      for (size_t i = 0; i < runLength; i++) {
+        this->charBuffer[bufferLength + i] = CodeUnitValue(run[i]);
+      }
+      this->sourceUnits.skipCodeUnits(runLength);
+    }
+
+    unit = getCodeUnit();
+    if (unit == untilChar) {
+      break;
+    }
+
     if (unit == EOF) {
       ReportPrematureEndOfLiteral(JSMSG_EOF_BEFORE_END_OF_LITERAL);
       return false;
@@ -619,15 +619,54 @@ void BackgroundAllocTask::run(AutoLockHelperThreadState& lock) {
       if (!ptr) {
         break;
       }
-      chunk = TenuredChunk::emplace(ptr, gc, /* allMemoryCommitted = */ true);
+      // In huge page mode, take the page faults here rather than on the main
+      // thread when the chunk is first used.
+      bool prefault = HugePagesEnabled();
+      if (prefault) {
+        PrefaultPages(ptr, ChunkSize);
+      }
+      chunk = TenuredChunk::emplace(ptr, gc, /* allMemoryCommitted = */ true,
+                                    /* prefaulted = */ prefault);
     }
     chunkPool_.ref().push(chunk);
   }
 }
 
+// A transparent huge page is 2MB on the platforms that support huge page mode,
+// which is larger than a chunk. A huge page can only back memory that is
+// aligned to its size and advised as a whole, so in huge page mode chunks are
+// mapped and advised in aligned pairs.
+static constexpr size_t HugePageChunkPairSize = 2 * ChunkSize;
+static_assert(HugePageChunkPairSize == 2 * 1024 * 1024);
+
+static void* MapHugePageChunk(GCRuntime* gc) {
+  // Use the other half of the last pair if it hasn't been used yet.
+  if (void* chunk = gc->spareHugePageChunk.exchange(nullptr)) {
+    return chunk;
+  }
+
+  void* pair = MapAlignedPages(HugePageChunkPairSize, HugePageChunkPairSize);
+  if (!pair) {
+    return nullptr;
+  }
+
+  MarkPagesHuge(pair, HugePageChunkPairSize);
+
+  // Keep the second chunk for the next allocation. Chunks are unmapped one at
+  // a time, which is fine for mmap'd memory. Another thread may have stored a
+  // spare chunk in the meantime, in which case this one is given back.
+  void* spare = static_cast<uint8_t*>(pair) + ChunkSize;
+  if (!gc->spareHugePageChunk.compareExchange(nullptr, spare)) {
+    UnmapPages(spare, ChunkSize);
+  }
+
+  return pair;
+}
+
 /* static */
 void* TenuredChunk::allocate(GCRuntime* gc) {
-  void* chunk = MapAlignedPages(ChunkSize, ChunkSize);
+  void* chunk = HugePagesEnabled() ? MapHugePageChunk(gc)
+                                   : MapAlignedPages(ChunkSize, ChunkSize);
   if (!chunk) {
     return nullptr;
   }
@@ -637,16 +676,23 @@ void* TenuredChunk::allocate(GCRuntime* gc) {
 }
 
 static inline bool ShouldDecommitNewChunk(bool allMemoryCommitted,
+                                          bool prefaulted,
                                           const GCSchedulingState& state) {
   if (!DecommitEnabled()) {
     return false;
   }
 
-  return !allMemoryCommitted || !state.inHighFrequencyGCMode();
+  if (!allMemoryCommitted) {
+    return true;
+  }
+
+  // Chunks allocated in the background are prefaulted in huge page mode and
+  // decommitting them would throw that work away.
+  return !prefaulted && !state.inHighFrequencyGCMode();
 }
 
 TenuredChunk* TenuredChunk::emplace(void* ptr, GCRuntime* gc,
-                                    bool allMemoryCommitted) {
+                                    bool allMemoryCommitted, bool prefaulted) {
   /* The chunk may still have some regions marked as no-access. */
   MOZ_MAKE_MEM_UNDEFINED(ptr, ChunkSize);
 
@@ -658,7 +704,8 @@ TenuredChunk* TenuredChunk::emplace(void* ptr, GCRuntime* gc,
 
   TenuredChunk* chunk = new (mozilla::KnownNotNull, ptr) TenuredChunk(gc->rt);
 
-  if (ShouldDecommitNewChunk(allMemoryCommitted, gc->schedulingState)) {
+  if (ShouldDecommitNewChunk(allMemoryCommitted, prefaulted,
+                             gc->schedulingState)) {
     // Decommit the arenas. We do this after poisoning so that if the OS does
     // not have to recycle the pages, we still get the benefit of poisoning.
     chunk->decommitAllArenas();
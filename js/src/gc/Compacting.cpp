@@ -671,6 +671,13 @@ void GCRuntime::updateCellPointers(Zone* zone, AllocKinds kinds) {
   for (; !fgArenas.done(); fgArenas.next()) {
     UpdateArenaListSegmentPointers(this, fgArenas.get());
   }
+
+  // Help the background tasks with any remaining arenas rather than waiting
+  // for them to finish.
+  SliceBudget budget = SliceBudget::unlimited();
+  RunParallelWorkOnCurrentThread<ArenaListSegment>(
+      this, GCUse::Unspecified, UpdateArenaListSegmentPointers, bgArenas,
+      budget);
 }
 
 // After cells have been relocated any pointers to a cell's old locations must
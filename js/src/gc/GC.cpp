@@ -934,6 +934,9 @@ void GCRuntime::finish() {
   FreeChunkPool(fullChunks_.ref());
   FreeChunkPool(availableChunks_.ref());
   FreeChunkPool(emptyChunks_.ref());
+  if (void* spare = spareHugePageChunk.exchange(nullptr)) {
+    UnmapPages(spare, ChunkSize);
+  }
 
   TlsGCContext.set(nullptr);
 
@@ -1000,6 +1000,11 @@ class GCRuntime {
   MainThreadOrGCTaskData<size_t> helperThreadCount;
   MainThreadData<size_t> markingThreadCount;
 
+  // In huge page mode, chunks are mapped in aligned pairs and this holds the
+  // second chunk of the most recent pair until it is needed. See
+  // TenuredChunk::allocate.
+  mozilla::Atomic<void*, mozilla::ReleaseAcquire> spareHugePageChunk;
+
   // State used for managing atom mark bitmaps in each zone.
   AtomMarkingRuntime atomMarking;
 
@@ -704,7 +704,8 @@ class TenuredChunk : public TenuredChunkBase {
 
   static void* allocate(GCRuntime* gc);
   static TenuredChunk* emplace(void* ptr, GCRuntime* gc,
-                               bool allMemoryCommitted);
+                               bool allMemoryCommitted,
+                               bool prefaulted = false);
 
   /* Unlink and return the freeArenasHead. */
   Arena* fetchNextFreeArena(GCRuntime* gc);
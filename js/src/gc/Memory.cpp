@@ -25,6 +25,9 @@
 
 #  include <algorithm>
 #  include <errno.h>
+#  include <stdio.h>
+#  include <stdlib.h>
+#  include <string.h>
 #  include <unistd.h>
 
 #  if !defined(__wasi__)
@@ -38,6 +41,13 @@
 
 namespace js::gc {
 
+/*
+ * Whether huge page mode was requested, see HugePagesEnabled(). This is only
+ * supported where the OS has transparent huge pages that can be requested
+ * with madvise.
+ */
+static bool hugePagesEnabled = false;
+
 /*
  * System allocation functions generally require the allocation size
  * to be an integer multiple of the page size of the running process.
@@ -401,6 +411,10 @@ void InitMemorySubsystem() {
 #else  // !defined(JS_64BIT)
     numAddressBits = 32;
 #endif
+#ifdef MADV_HUGEPAGE
+    const char* env = getenv("JS_GC_HUGE_PAGES");
+    hugePagesEnabled = env && *env == '1';
+#endif
 #ifdef RLIMIT_AS
     if (jit::HasJitBackend()) {
       rlimit as_limit;
@@ -892,6 +906,65 @@ size_t GetPageFaultCount() {
 #endif
 }
 
+bool HugePagesEnabled() { return hugePagesEnabled; }
+
+void MarkPagesHuge(void* region, size_t length) {
+  MOZ_ASSERT(OffsetFromAligned(region, pageSize) == 0);
+  MOZ_ASSERT(length % pageSize == 0);
+
+  if (!hugePagesEnabled) {
+    return;
+  }
+
+#ifdef MADV_HUGEPAGE
+  // This is only advice: the kernel may not have huge pages available, or may
+  // be configured to ignore it, and both are fine.
+  (void)madvise(region, length, MADV_HUGEPAGE);
+#endif
+}
+
+void PrefaultPages(void* region, size_t length) {
+  MOZ_ASSERT(OffsetFromAligned(region, pageSize) == 0);
+  MOZ_ASSERT(length % pageSize == 0);
+
+#ifdef MADV_POPULATE_WRITE
+  if (madvise(region, length, MADV_POPULATE_WRITE) == 0) {
+    return;
+  }
+#endif
+
+  // Fall back to touching each page. The memory is freshly mapped and so
+  // already zero, which means the writes don't change its contents.
+  volatile uint8_t* p = static_cast<uint8_t*>(region);
+  for (size_t offset = 0; offset < length; offset += pageSize) {
+    p[offset] = 0;
+  }
+}
+
+size_t GetHugePageBytes() {
+#if defined(XP_LINUX) && defined(MADV_HUGEPAGE)
+  FILE* file = fopen("/proc/self/smaps_rollup", "r");
+  if (!file) {
+    return 0;
+  }
+
+  size_t bytes = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    static const char prefix[] = "AnonHugePages:";
+    if (strncmp(line, prefix, sizeof(prefix) - 1) == 0) {
+      bytes = size_t(strtoull(line + sizeof(prefix) - 1, nullptr, 10)) * 1024;
+      break;
+    }
+  }
+
+  fclose(file);
+  return bytes;
+#else
+  return 0;
+#endif
+}
+
 void* AllocateMappedContent(int fd, size_t offset, size_t length,
                             size_t alignment) {
 #ifdef __wasi__
@@ -64,6 +64,23 @@ void MarkPagesInUseSoft(void* region, size_t length);
 // Returns #(hard faults) + #(soft faults)
 size_t GetPageFaultCount();
 
+// Whether GC chunks and wasm memories should be backed by huge pages. This is
+// off by default and enabled by setting JS_GC_HUGE_PAGES=1 in the environment.
+// It's currently only supported on Linux, using transparent huge pages.
+bool HugePagesEnabled();
+
+// Ask the OS to back the given region with huge pages where possible. This is
+// a no-op unless HugePagesEnabled() is true.
+void MarkPagesHuge(void* region, size_t length);
+
+// Fault in the given committed pages now, so that the cost is paid by the
+// calling thread rather than by whichever thread first writes to them.
+void PrefaultPages(void* region, size_t length);
+
+// Returns the number of bytes of anonymous memory in this process that the OS
+// currently backs with huge pages, or zero if this can't be determined.
+size_t GetHugePageBytes();
+
 // Allocate memory mapped content.
 // The offset must be aligned according to alignment requirement.
 void* AllocateMappedContent(int fd, size_t offset, size_t length,
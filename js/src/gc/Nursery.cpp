@@ -844,6 +844,8 @@ void js::Nursery::renderProfileJSON(JSONPrinter& json) const {
                 stats().getStat(gcstats::STAT_STRINGS_DEDUPLICATED));
   json.property("bigints_tenured",
                 stats().getStat(gcstats::STAT_BIGINTS_TENURED));
+  json.property("bigints_deduplicated",
+                stats().getStat(gcstats::STAT_BIGINTS_DEDUPLICATED));
   json.property("bytes_used", previousGC.nurseryUsedBytes);
   json.property("cur_capacity", previousGC.nurseryCapacity);
   const size_t newCapacity = capacity();
@@ -1563,6 +1565,7 @@ size_t js::Nursery::doPretenuring(JSRuntime* rt, JS::GCReason reason,
 
   uint32_t numStringsTenured = 0;
   uint32_t numBigIntsTenured = 0;
+  uint32_t numBigIntsDeduplicated = 0;
   for (ZonesIter zone(gc, SkipAtoms); !zone.done(); zone.next()) {
     // For some tests in JetStream2 and Kraken, the tenuredRate is high but the
     // number of allocated strings is low. So we calculate the tenuredRate only
@@ -1594,9 +1597,12 @@ size_t js::Nursery::doPretenuring(JSRuntime* rt, JS::GCReason reason,
     numStringsTenured += zoneTenuredStrings;
     numBigIntsTenured += zone->tenuredBigInts;
     zone->tenuredBigInts = 0;
+    numBigIntsDeduplicated += zone->deduplicatedBigInts;
+    zone->deduplicatedBigInts = 0;
   }
   stats().setStat(gcstats::STAT_STRINGS_TENURED, numStringsTenured);
   stats().setStat(gcstats::STAT_BIGINTS_TENURED, numBigIntsTenured);
+  stats().setStat(gcstats::STAT_BIGINTS_DEDUPLICATED, numBigIntsDeduplicated);
 
   return sitesPretenured;
 }
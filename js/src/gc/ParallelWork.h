@@ -11,6 +11,7 @@
 
 #include <algorithm>
 
+#include "gc/GCInternals.h"
 #include "gc/GCParallelTask.h"
 #include "gc/GCRuntime.h"
 #include "js/SliceBudget.h"
@@ -87,6 +88,39 @@ class ParallelWorker : public GCParallelTask {
 
 static constexpr size_t MaxParallelWorkers = 8;
 
+// Execute WorkItems from a WorkItemIterator on the current thread until there
+// are none left or the budget is exhausted. This is used so that the main
+// thread can take work from the same iterator as the ParallelWorkers started
+// by AutoRunParallelWork, rather than sitting idle while it waits for them.
+//
+// The helper thread lock must not be held by the caller.
+template <typename WorkItem, typename WorkItemIterator>
+void RunParallelWorkOnCurrentThread(GCRuntime* gc, GCUse use,
+                                    ParallelWorkFunc<WorkItem> func,
+                                    WorkItemIterator& work,
+                                    SliceBudget& budget) {
+  AutoSetThreadGCUse setUse(gc->rt->gcContext(), use);
+
+  for (;;) {
+    mozilla::Maybe<WorkItem> item;
+    {
+      AutoLockHelperThreadState lock;
+      if (work.done()) {
+        return;
+      }
+
+      item.emplace(work.get());
+      work.next();
+    }
+
+    size_t steps = func(gc, item.ref());
+    budget.step(std::max(steps, size_t(1)));
+    if (budget.isOverBudget()) {
+      return;
+    }
+  }
+}
+
 // An RAII class that starts a number of ParallelWorkers and waits for them to
 // finish.
 template <typename WorkItem, typename WorkItemIterator>
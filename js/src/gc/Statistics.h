@@ -70,6 +70,9 @@ enum Stat {
   // Number of BigInts tenured.
   STAT_BIGINTS_TENURED,
 
+  // Number of BigInts deduplicated.
+  STAT_BIGINTS_DEDUPLICATED,
+
   STAT_LIMIT
 };
 
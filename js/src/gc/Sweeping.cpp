@@ -1945,6 +1945,8 @@ IncrementalProgress GCRuntime::sweepWeakCaches(JS::GCContext* gcx,
                                 gcstats::PhaseKind::SWEEP_WEAK_CACHES,
                                 GCUse::Sweeping, work, budget, lock);
     AutoUnlockHelperThreadState unlock(lock);
+    RunParallelWorkOnCurrentThread<WeakCacheToSweep>(
+        this, GCUse::Sweeping, IncrementalSweepWeakCache, work, budget);
   }
 
   if (work.done()) {
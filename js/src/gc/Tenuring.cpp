@@ -12,6 +12,8 @@
 
 #include "mozilla/PodOperations.h"
 
+#include <algorithm>
+
 #include "gc/Cell.h"
 #include "gc/GCInternals.h"
 #include "gc/GCProbes.h"
@@ -43,11 +45,38 @@ using mozilla::PodCopy;
 
 constexpr size_t MAX_DEDUPLICATABLE_STRING_LENGTH = 500;
 
+// Like strings, only BigInts short enough to be cheap to hash are
+// deduplicated.
+constexpr size_t MAX_DEDUPLICATABLE_BIGINT_DIGITS = 64;
+
+/* static */
+HashNumber DeduplicationBigIntHasher::hash(const Lookup& lookup) {
+  JS::BigInt::ConstDigits digits = lookup->digits();
+  HashNumber digitsHash =
+      mozilla::HashBytes(digits.data(), digits.size() * sizeof(digits[0]));
+  return mozilla::HashGeneric(digitsHash, lookup->isNegative(),
+                              lookup->zone());
+}
+
+/* static */
+bool DeduplicationBigIntHasher::match(JS::BigInt* key, const Lookup& lookup) {
+  if (key->digitLength() != lookup->digitLength() ||
+      key->isNegative() != lookup->isNegative() ||
+      key->asTenured().zone() != lookup->zone()) {
+    return false;
+  }
+
+  JS::BigInt::ConstDigits keyDigits = key->digits();
+  JS::BigInt::ConstDigits lookupDigits = lookup->digits();
+  return std::equal(keyDigits.begin(), keyDigits.end(), lookupDigits.begin());
+}
+
 TenuringTracer::TenuringTracer(JSRuntime* rt, Nursery* nursery)
     : JSTracer(rt, JS::TracerKind::Tenuring,
                JS::WeakMapTraceAction::TraceKeysAndValues),
       nursery_(*nursery) {
   stringDeDupSet.emplace();
+  bigIntDeDupSet.emplace();
 }
 
 size_t TenuringTracer::getTenuredSize() const {
@@ -810,7 +839,8 @@ JSString* js::gc::TenuringTracer::moveToTenured(JSString* src) {
     MOZ_ASSERT(DedupHasher::hash(src) == DedupHasher::hash(dst),
                "src and dst must have the same hash for lookupForAdd");
 
-    if (!stringDeDupSet->add(p, dst)) {
+    if (stringDeDupSet->count() < MaxDeduplicationEntries &&
+        !stringDeDupSet->add(p, dst)) {
       // When there is oom caused by the stringDeDupSet, stop deduplicating
       // strings.
       stringDeDupSet.reset();
@@ -904,12 +934,39 @@ JS::BigInt* js::gc::TenuringTracer::moveToTenured(JS::BigInt* src) {
 
   AllocKind dstKind = src->getAllocKind();
   Zone* zone = src->nurseryZone();
+
+  // Deduplicate short BigInts against the ones already tenured by this
+  // collection. Any heap digits |src| owns are freed with the nursery's other
+  // unclaimed buffers.
+  BigIntDeDupSet::AddPtr p;
+  bool deduplicatable =
+      src->digitLength() <= MAX_DEDUPLICATABLE_BIGINT_DIGITS &&
+      bigIntDeDupSet.isSome();
+  if (deduplicatable) {
+    p = bigIntDeDupSet->lookupForAdd(src);
+    if (p) {
+      JS::BigInt* dst = *p;
+      zone->deduplicatedBigInts++;
+      RelocationOverlay::forwardCell(src, dst);
+      gcprobes::PromoteToTenured(src, dst);
+      return dst;
+    }
+  }
+
+  // Only count BigInts that are actually allocated in the tenured heap, since
+  // this feeds the nursery BigInt pretenuring decision.
   zone->tenuredBigInts++;
 
   JS::BigInt* dst = allocTenured<JS::BigInt>(zone, dstKind);
   tenuredSize += moveBigIntToTenured(dst, src, dstKind);
   tenuredCells++;
 
+  if (deduplicatable && bigIntDeDupSet->count() < MaxDeduplicationEntries &&
+      !bigIntDeDupSet->add(p, dst)) {
+    // As for strings, stop deduplicating BigInts on OOM.
+    bigIntDeDupSet.reset();
+  }
+
   RelocationOverlay::forwardCell(src, dst);
 
   gcprobes::PromoteToTenured(src, dst);
@@ -79,6 +79,15 @@ struct DeduplicationStringHasher {
   }
 };
 
+// BigInts are immutable and have no identity, so any two with the same zone,
+// sign and digits can be merged.
+struct DeduplicationBigIntHasher {
+  using Lookup = JS::BigInt*;
+
+  static inline HashNumber hash(const Lookup& lookup);
+  static inline bool match(JS::BigInt* key, const Lookup& lookup);
+};
+
 class TenuringTracer final : public JSTracer {
   Nursery& nursery_;
 
@@ -97,10 +106,18 @@ class TenuringTracer final : public JSTracer {
       HashSet<JSString*, DeduplicationStringHasher<JSString*>,
               SystemAllocPolicy>;
 
-  // deDupSet is emplaced at the beginning of the nursery collection and reset
-  // at the end of the nursery collection. It can also be reset during nursery
-  // collection when out of memory to insert new entries.
+  using BigIntDeDupSet =
+      HashSet<JS::BigInt*, DeduplicationBigIntHasher, SystemAllocPolicy>;
+
+  // The deduplication sets are emplaced at the beginning of the nursery
+  // collection and reset at the end of the nursery collection. They can also
+  // be reset during nursery collection when out of memory to insert new
+  // entries. Once a set holds MaxDeduplicationEntries entries, later cells can
+  // still be deduplicated against it but aren't added, which bounds both its
+  // size and the cost of growing it during a minor GC.
+  static constexpr size_t MaxDeduplicationEntries = 64 * 1024;
   mozilla::Maybe<StringDeDupSet> stringDeDupSet;
+  mozilla::Maybe<BigIntDeDupSet> bigIntDeDupSet;
 
 #define DEFINE_ON_EDGE_METHOD(name, type, _1, _2) \
   void on##name##Edge(type** thingp, const char* name) override;
@@ -160,6 +160,7 @@ JS::Zone::Zone(JSRuntime* rt, Kind kind)
       arenas(this),
       data(nullptr),
       tenuredBigInts(0),
+      deduplicatedBigInts(0),
       markedStrings(0),
       finalizedStrings(0),
       suppressAllocationMetadataBuilder(false),
@@ -172,6 +172,7 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   js::MainThreadData<void*> data;
 
   js::MainThreadData<uint32_t> tenuredBigInts;
+  js::MainThreadData<uint32_t> deduplicatedBigInts;
 
   // Number of marked/finalized JSStrings/JSFatInlineStrings during major GC.
   js::MainThreadOrGCTaskData<size_t> markedStrings;
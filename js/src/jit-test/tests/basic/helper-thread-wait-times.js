@@ -0,0 +1,33 @@
+// |jit-test| skip-if: helperThreadCount() === 0
+
+function checkStats(times) {
+  for (let name of Object.keys(times)) {
+    let stats = times[name];
+    assertEq(stats.count >= 1, true);
+    assertEq(stats.totalMs >= 0, true);
+    assertEq(stats.maxMs >= 0, true);
+    assertEq(stats.maxMs <= stats.totalMs, true);
+  }
+}
+
+// Start from empty statistics. Other kinds of task, such as GC tasks, may run
+// at any time, so only parse tasks are counted below.
+helperThreadWaitTimes(true);
+assertEq("parse" in helperThreadWaitTimes(), false);
+
+// Run a parse task on a helper thread and check it was recorded.
+offThreadCompileToStencil("1 + 1");
+finishOffThreadStencil();
+
+let times = helperThreadWaitTimes();
+checkStats(times);
+assertEq(times.parse.count, 1);
+
+// Reading without |reset| keeps the statistics.
+assertEq(helperThreadWaitTimes().parse.count, 1);
+
+// Reading with |reset| returns them one last time and then clears them.
+times = helperThreadWaitTimes(true);
+checkStats(times);
+assertEq(times.parse.count, 1);
+assertEq("parse" in helperThreadWaitTimes(), false);
@@ -25,15 +25,13 @@ inline void JitHintsMap::incrementBaselineEntryCount() {
   // calculated by MaxEntries.
   if (++baselineEntryCount_ > MaxEntries_) {
     baselineHintMap_.clear();
+    baselineHintKeys_.clear();
     baselineEntryCount_ = 0;
   }
 }
 
-inline void JitHintsMap::setEagerBaselineHint(JSScript* script) {
-  ScriptKey key = getScriptKey(script);
-  if (!key) {
-    return;
-  }
+inline void JitHintsMap::addEagerBaselineHint(ScriptKey key) {
+  MOZ_ASSERT(key);
 
   // If the entry already exists, don't increment entryCount.
   if (baselineHintMap_.mightContain(key)) {
@@ -43,8 +41,18 @@ inline void JitHintsMap::setEagerBaselineHint(JSScript* script) {
   // Increment entry count, and possibly clear the cache.
   incrementBaselineEntryCount();
 
-  script->setNoEagerBaselineHint(false);
   baselineHintMap_.add(key);
+  (void)baselineHintKeys_.append(key);
+}
+
+inline void JitHintsMap::setEagerBaselineHint(JSScript* script) {
+  ScriptKey key = getScriptKey(script);
+  if (!key) {
+    return;
+  }
+
+  script->setNoEagerBaselineHint(false);
+  addEagerBaselineHint(key);
 }
 
 inline bool JitHintsMap::mightHaveEagerBaselineHint(JSScript* script) const {
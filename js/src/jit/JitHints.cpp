@@ -5,6 +5,9 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "jit/JitHints-inl.h"
+
+#include <string.h>
+
 #include "vm/JSScript-inl.h"
 
 using namespace js;
@@ -91,3 +94,100 @@ void JitHintsMap::recordInvalidation(JSScript* script) {
     }
   }
 }
+
+// The encoding is a header followed by the baseline hint keys and then the
+// Ion hints, least recently used first, all in native byte order:
+//
+//   uint32_t magic, version, baselineCount, ionCount
+//   ScriptKey baselineKeys[baselineCount]
+//   { ScriptKey key; uint32_t threshold; } ionHints[ionCount]
+static constexpr uint32_t JitHintsMagic = 0x4a48494e;  // 'JHIN'
+static constexpr uint32_t JitHintsVersion = 1;
+
+template <typename T>
+static bool AppendValue(mozilla::Vector<uint8_t>& buffer, T value) {
+  return buffer.append(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T ReadValue(const uint8_t*& cursor) {
+  T value;
+  memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+bool JitHintsMap::encode(mozilla::Vector<uint8_t>& buffer) const {
+  if (!AppendValue(buffer, JitHintsMagic) ||
+      !AppendValue(buffer, JitHintsVersion) ||
+      !AppendValue(buffer, uint32_t(baselineHintKeys_.length())) ||
+      !AppendValue(buffer, uint32_t(ionHintMap_.count()))) {
+    return false;
+  }
+
+  for (ScriptKey key : baselineHintKeys_) {
+    if (!AppendValue(buffer, key)) {
+      return false;
+    }
+  }
+
+  for (const IonHint* hint = ionHintQueue_.getFirst(); hint;
+       hint = hint->getNext()) {
+    if (!AppendValue(buffer, hint->key()) ||
+        !AppendValue(buffer, hint->threshold())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool JitHintsMap::decode(const uint8_t* data, size_t length) {
+  constexpr size_t HeaderSize = 4 * sizeof(uint32_t);
+  constexpr size_t IonHintSize = sizeof(ScriptKey) + sizeof(uint32_t);
+
+  if (length < HeaderSize) {
+    return false;
+  }
+
+  const uint8_t* cursor = data;
+  uint32_t magic = ReadValue<uint32_t>(cursor);
+  uint32_t version = ReadValue<uint32_t>(cursor);
+  uint32_t baselineCount = ReadValue<uint32_t>(cursor);
+  uint32_t ionCount = ReadValue<uint32_t>(cursor);
+  if (magic != JitHintsMagic || version != JitHintsVersion ||
+      baselineCount > MaxEntries_ || ionCount > IonHintMaxEntries ||
+      length != HeaderSize + baselineCount * sizeof(ScriptKey) +
+                    ionCount * IonHintSize) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < baselineCount; i++) {
+    if (ScriptKey key = ReadValue<ScriptKey>(cursor)) {
+      addEagerBaselineHint(key);
+    }
+  }
+
+  for (uint32_t i = 0; i < ionCount; i++) {
+    ScriptKey key = ReadValue<ScriptKey>(cursor);
+    uint32_t threshold = ReadValue<uint32_t>(cursor);
+    if (!key) {
+      continue;
+    }
+
+    auto p = ionHintMap_.lookupForAdd(key);
+    if (p) {
+      // Don't modify existing threshold values.
+      continue;
+    }
+
+    IonHint* hint = addIonHint(key, p);
+    if (!hint) {
+      return false;
+    }
+    hint->setThreshold(threshold);
+  }
+
+  MOZ_ASSERT(cursor == data + length);
+  return true;
+}
@@ -10,6 +10,7 @@
 #include "mozilla/BloomFilter.h"
 #include "mozilla/HashTable.h"
 #include "mozilla/LinkedList.h"
+#include "mozilla/Vector.h"
 #include "jit/JitOptions.h"
 #include "vm/JSScript.h"
 
@@ -26,6 +27,12 @@ namespace js::jit {
  * value, and if we ever encounter this script again later, e.g. during a
  * navigation, then we try to eagerly compile it into baseline and ion
  * based on its previous execution history.
+ *
+ * The hints don't refer to any GC things, so they can also be encoded into a
+ * buffer and decoded into the map of a later runtime, possibly in another
+ * process, to skip warmup for scripts that were hot there (see
+ * JS::EncodeJitHints). The encoding is only meant to be read by the same
+ * build.
  */
 
 class JitHintsMap {
@@ -57,16 +64,17 @@ class JitHintsMap {
       threshold_ = IonHintEagerThresholdValue();
     }
 
-    uint32_t threshold() { return threshold_; }
+    uint32_t threshold() const { return threshold_; }
+
+    void incThreshold(uint32_t inc) { setThreshold(threshold() + inc); }
 
-    void incThreshold(uint32_t inc) {
-      uint32_t newThreshold = threshold() + inc;
+    void setThreshold(uint32_t newThreshold) {
       threshold_ = (newThreshold > JitOptions.normalIonWarmUpThreshold)
                        ? JitOptions.normalIonWarmUpThreshold
                        : newThreshold;
     }
 
-    ScriptKey key() {
+    ScriptKey key() const {
       MOZ_ASSERT(key_ != 0, "Should have valid key.");
       return key_;
     }
@@ -125,6 +133,13 @@ class JitHintsMap {
   uint32_t baselineEntryCount_ = 0;
   void incrementBaselineEntryCount();
 
+  // The keys that have been added to |baselineHintMap_| since it was last
+  // cleared, which are needed to encode it. Failing to append a key only
+  // means it is left out of the encoding.
+  Vector<ScriptKey, 0, SystemAllocPolicy> baselineHintKeys_;
+
+  void addEagerBaselineHint(ScriptKey key);
+
   void updateAsRecentlyUsed(IonHint* hint);
   IonHint* addIonHint(ScriptKey key, ScriptToHintMap::AddPtr& p);
 
@@ -138,6 +153,15 @@ class JitHintsMap {
   bool getIonThresholdHint(JSScript* script, uint32_t& thresholdOut);
 
   void recordInvalidation(JSScript* script);
+
+  // Append an encoding of all the hints to |buffer|.
+  bool encode(mozilla::Vector<uint8_t>& buffer) const;
+
+  // Add the hints from an encoding produced by |encode|, keeping any existing
+  // Ion threshold values. Returns false if the encoding is invalid, in which
+  // case no hints are added, or on OOM, in which case the hints decoded before
+  // the failure are kept.
+  bool decode(const uint8_t* data, size_t length);
 };
 
 }  // namespace js::jit
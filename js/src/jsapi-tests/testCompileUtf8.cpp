@@ -9,7 +9,7 @@
 #include <cstring>
 
 #include "js/CharacterEncoding.h"
-#include "js/CompilationAndEvaluation.h"  // JS::Compile
+#include "js/CompilationAndEvaluation.h"  // JS::Compile, JS::Evaluate
 #include "js/Exception.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/SourceText.h"
@@ -298,3 +298,67 @@ bool testContext(const char (&chars)[N],
   return true;
 }
 END_TEST(testMultiUnitUtf8InWindow)
+
+// Comments, string and template literals, identifiers and indentation long
+// enough to be scanned in bulk, with the code units that end each run at
+// offsets that aren't word-aligned. Each source is evaluated as UTF-8 and as
+// UTF-16 and must produce the expected string.
+BEGIN_TEST(testLongTokenRuns) {
+  CHECK(testBothEncodings(
+      "var aVeryLongIdentifierNameIndeed_$1 = 'x';\n"
+      "aVeryLongIdentifierNameIndeed_$1 + 'abcdefghijklmnopqrstuvwxyz'",
+      "xabcdefghijklmnopqrstuvwxyz"));
+
+  CHECK(testBothEncodings("'abcdefghijklm\\nopqrstuvwxyz\\'0123456789\"!'",
+                          "abcdefghijklm\nopqrstuvwxyz'0123456789\"!"));
+
+  CHECK(testBothEncodings("var a = 'A'; `abcdefghijk$lmnop${a}qrstuvwxyz$`",
+                          "abcdefghijk$lmnopAqrstuvwxyz$"));
+
+  CHECK(testBothEncodings("`abcdefghijklmnop\r\nqrstuvwxyz`",
+                          "abcdefghijklmnop\nqrstuvwxyz"));
+
+  CHECK(testBothEncodings(
+      "var s = 'a'; // a comment that is long enough to span words\n"
+      "            s += 'b'; // another\r"
+      "\t\t\t\t\t\t\t\t\t\ts += 'c';   \t   // and one at the end",
+      "abc"));
+
+  return true;
+}
+
+bool testBothEncodings(const char* source, const char* expected) {
+  size_t length = strlen(source);
+
+  JS::Rooted<JS::Value> utf8Result(cx);
+  {
+    JS::CompileOptions options(cx);
+    JS::SourceText<Utf8Unit> srcBuf;
+    CHECK(srcBuf.init(cx, source, length, JS::SourceOwnership::Borrowed));
+    CHECK(JS::Evaluate(cx, options, srcBuf, &utf8Result));
+  }
+
+  JS::Rooted<JS::Value> utf16Result(cx);
+  {
+    JS::UniqueTwoByteChars chars(js_pod_malloc<char16_t>(length));
+    CHECK(chars);
+    for (size_t i = 0; i < length; i++) {
+      chars[i] = char16_t(source[i]);
+    }
+
+    JS::CompileOptions options(cx);
+    JS::SourceText<char16_t> srcBuf;
+    CHECK(srcBuf.init(cx, chars.get(), length, JS::SourceOwnership::Borrowed));
+    CHECK(JS::Evaluate(cx, options, srcBuf, &utf16Result));
+  }
+
+  for (JS::Value result : {utf8Result.get(), utf16Result.get()}) {
+    CHECK(result.isString());
+    bool match;
+    CHECK(JS_StringEqualsAscii(cx, result.toString(), expected, &match));
+    CHECK(match);
+  }
+
+  return true;
+}
+END_TEST(testLongTokenRuns)
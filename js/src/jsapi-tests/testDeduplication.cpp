@@ -9,12 +9,14 @@
 
 #include "gc/GC.h"
 
+#include "js/BigInt.h"  // JS::SimpleStringToBigInt
 #include "js/RootingAPI.h"
 #include "js/StableStringChars.h"
 #include "js/String.h"  // JS::StringToLinearString
 
 #include "jsapi-tests/tests.h"
 
+#include "vm/BigIntType.h"
 #include "vm/JSContext.h"
 #include "vm/StringType.h"
 
@@ -111,3 +113,41 @@ BEGIN_TEST(testDeduplication_ASSC) {
   return true;
 }
 END_TEST(testDeduplication_ASSC)
+
+BEGIN_TEST(testDeduplication_BigInt) {
+  // Equal BigInts tenured by the same minor GC are merged, whether their
+  // digits are inline or on the heap.
+  static const char small[] = "12345";
+  static const char large[] = "123456789012345678901234567890123456789";
+
+  JS::Rooted<JS::BigInt*> small1(cx, newBigInt(small));
+  JS::Rooted<JS::BigInt*> small2(cx, newBigInt(small));
+  JS::Rooted<JS::BigInt*> negative(cx, newBigInt("-12345"));
+  JS::Rooted<JS::BigInt*> large1(cx, newBigInt(large));
+  JS::Rooted<JS::BigInt*> large2(cx, newBigInt(large));
+  CHECK(small1 && small2 && negative && large1 && large2);
+
+  if (!js::gc::IsInsideNursery(small1) || !js::gc::IsInsideNursery(large1)) {
+    // Nursery BigInts are disabled in this zone.
+    return true;
+  }
+  CHECK(small1 != small2);
+  CHECK(large1 != large2);
+
+  cx->minorGC(JS::GCReason::API);
+
+  CHECK(!js::gc::IsInsideNursery(small1));
+  CHECK_EQUAL(small1.get(), small2.get());
+  CHECK_EQUAL(large1.get(), large2.get());
+  CHECK(small1 != negative);
+  CHECK(small1 != large1);
+  CHECK(JS::BigIntIsNegative(negative));
+
+  return true;
+}
+
+JS::BigInt* newBigInt(const char* digits) {
+  return JS::SimpleStringToBigInt(
+      cx, mozilla::Span<const char>(digits, strlen(digits)), 10);
+}
+END_TEST(testDeduplication_BigInt)
@@ -0,0 +1,58 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/Utf8.h"
+#include "mozilla/Vector.h"
+
+#include "jit/JitHints.h"
+#include "js/CompilationAndEvaluation.h"  // JS::Compile
+#include "js/SourceText.h"
+#include "js/UniquePtr.h"
+#include "jsapi-tests/tests.h"
+
+#include "jit/JitHints-inl.h"
+
+using js::jit::JitHintsMap;
+
+BEGIN_TEST(testJitHints_EncodeDecode) {
+  static const char src[] = "function f() { return 1; }";
+
+  JS::CompileOptions options(cx);
+  options.setFileAndLine("testJitHints.js", 1);
+  JS::SourceText<mozilla::Utf8Unit> srcBuf;
+  CHECK(srcBuf.init(cx, src, sizeof(src) - 1, JS::SourceOwnership::Borrowed));
+  JS::RootedScript script(cx, JS::Compile(cx, options, srcBuf));
+  CHECK(script);
+
+  js::UniquePtr<JitHintsMap> hints = js::MakeUnique<JitHintsMap>();
+  CHECK(hints);
+  hints->setEagerBaselineHint(script);
+  CHECK(hints->recordIonCompilation(script));
+  uint32_t threshold;
+  CHECK(hints->getIonThresholdHint(script, threshold));
+
+  mozilla::Vector<uint8_t> buffer;
+  CHECK(hints->encode(buffer));
+
+  // A new map starts with the same hints.
+  js::UniquePtr<JitHintsMap> decoded = js::MakeUnique<JitHintsMap>();
+  CHECK(decoded);
+  CHECK(!decoded->mightHaveEagerBaselineHint(script));
+  CHECK(decoded->decode(buffer.begin(), buffer.length()));
+  CHECK(decoded->mightHaveEagerBaselineHint(script));
+  uint32_t decodedThreshold;
+  CHECK(decoded->getIonThresholdHint(script, decodedThreshold));
+  CHECK_EQUAL(decodedThreshold, threshold);
+
+  // Truncated or corrupt encodings are rejected without adding any hints.
+  js::UniquePtr<JitHintsMap> rejected = js::MakeUnique<JitHintsMap>();
+  CHECK(rejected);
+  CHECK(!rejected->decode(buffer.begin(), buffer.length() - 1));
+  buffer[0] ^= 1;
+  CHECK(!rejected->decode(buffer.begin(), buffer.length()));
+  CHECK(!rejected->getIonThresholdHint(script, decodedThreshold));
+
+  return true;
+}
+END_TEST(testJitHints_EncodeDecode)
@@ -0,0 +1,121 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/tests.h"
+
+// These arrays are large enough to use the helper thread sort (see
+// ParallelSortMinLength). Each result is compared against sorting with an
+// equivalent user-supplied comparator, which always sorts on the main thread.
+
+static const char ParallelSortPrelude[] =
+    "var N = 300000;"
+    "var seed = 1;"
+    "function rand() {"
+    "  seed = (seed * 1103515245 + 12345) % 2147483648;"
+    "  return seed;"
+    "}"
+    "function same(a, b) {"
+    "  if (a.length !== b.length) return false;"
+    "  for (var i = 0; i < a.length; i++) {"
+    "    if (!Object.is(a[i], b[i])) return false;"
+    "  }"
+    "  return true;"
+    "}"
+    "function cmp(a, b) {"
+    "  if (a !== a) return b !== b ? 0 : 1;"
+    "  if (b !== b) return -1;"
+    "  if (a < b) return -1;"
+    "  if (a > b) return 1;"
+    "  if (Object.is(a, -0) && Object.is(b, 0)) return -1;"
+    "  if (Object.is(a, 0) && Object.is(b, -0)) return 1;"
+    "  return 0;"
+    "}"
+    "function cmpString(a, b) { return cmp(String(a), String(b)); }";
+
+BEGIN_TEST(testParallelSort_Int32) {
+  EXEC(ParallelSortPrelude);
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "var a = [];"
+      "for (var i = 0; i < N; i++) a.push((rand() % 20000) - 10000);"
+      "same(a.slice().sort((x, y) => x - y), a.slice().sort(cmp)) &&"
+      "same(a.slice().sort((x, y) => y - x), a.slice().sort(cmp).reverse()) &&"
+      "same(a.slice().sort(), a.slice().sort(cmpString));",
+      &v);
+  CHECK(v.isTrue());
+
+  EVAL(
+      "var ta = new Int32Array(N);"
+      "for (var i = 0; i < N; i++) ta[i] = rand() - 1073741824;"
+      "same(ta.slice().sort(), ta.slice().sort(cmp));",
+      &v);
+  CHECK(v.isTrue());
+
+  return true;
+}
+END_TEST(testParallelSort_Int32)
+
+BEGIN_TEST(testParallelSort_Float64) {
+  EXEC(ParallelSortPrelude);
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "var specials = [NaN, -0, 0, Infinity, -Infinity, 1e-310];"
+      "var ta = new Float64Array(N);"
+      "for (var i = 0; i < N; i++) {"
+      "  var r = rand();"
+      "  ta[i] = r % 97 === 0 ? specials[r % specials.length]"
+      "                       : (r - 1073741824) / 4096;"
+      "}"
+      "same(ta.slice().sort(), ta.slice().sort(cmp));",
+      &v);
+  CHECK(v.isTrue());
+
+  // Doubles in an ordinary array go through SortNumerically. Use only values
+  // that |x - y| orders the same way as |cmp|.
+  EVAL(
+      "var a = Array.from(ta, x => (x !== x ? 0.5 : x === 0 ? 0 : x));"
+      "same(a.slice().sort((x, y) => x - y), a.slice().sort(cmp));",
+      &v);
+  CHECK(v.isTrue());
+
+  return true;
+}
+END_TEST(testParallelSort_Float64)
+
+BEGIN_TEST(testParallelSort_Strings) {
+  EXEC(ParallelSortPrelude);
+
+  JS::RootedValue v(cx);
+
+  // Include ropes, which are flattened before sorting.
+  EVAL(
+      "var a = [];"
+      "for (var i = 0; i < N; i++) {"
+      "  var s = (rand() % 5000).toString(36);"
+      "  a.push(i % 3 ? s : s + 'x'.repeat(32 + (i % 8)));"
+      "}"
+      "same(a.slice().sort(), a.slice().sort(cmp));",
+      &v);
+  CHECK(v.isTrue());
+
+  // Mixed strings and numbers are compared as strings, and the sort must be
+  // stable: 7 and '7' keep their relative order.
+  EVAL(
+      "var a = [];"
+      "for (var i = 0; i < N; i++) {"
+      "  var n = rand() % 5000;"
+      "  a.push(i % 2 ? n : String(n));"
+      "}"
+      "same(a.slice().sort(), a.slice().sort(cmpString));",
+      &v);
+  CHECK(v.isTrue());
+
+  return true;
+}
+END_TEST(testParallelSort_Strings)
@@ -113,6 +113,20 @@ BEGIN_TEST(testParseJSON_success) {
   CHECK(TryParse(cx, "\"\\n\"", expected));
   CHECK(TryParse(cx, "\"\\u000A\"", expected));
 
+  // Strings long enough to be scanned a word at a time, with escapes and the
+  // closing quote at offsets that aren't word-aligned.
+  const char16_t longstr[] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i',
+                              'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r',
+                              's', '\n', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+                              '"', '0', '1', '2', '3', '4', '5', '6', '7'};
+  str = NewString(cx, longstr);
+  CHECK(str);
+  expected = JS::StringValue(str);
+  CHECK(TryParse(cx, "\"abcdefghijklmnopqrs\\ntuvwxyz\\\"01234567\"",
+                 expected));
+  CHECK(TryParse(cx, "\"abcdefghijklmnopqrs\\u000Atuvwxyz\\u002201234567\"",
+                 expected));
+
   // Arrays
   JS::RootedValue v(cx), v2(cx);
   JS::RootedObject obj(cx);
@@ -240,6 +254,9 @@ BEGIN_TEST(testParseJSON_error) {
   CHECK(Error(cx, "\r\n[}", 2, 2));
   CHECK(Error(cx, "{\"a\":[2,3],\r\n\"b\":,5,6}", 2, 5));
 
+  CHECK(Error(cx, "\"abcdefghijklmnopqrstuvwxyz\x01\"", 1, 28));
+  CHECK(Error(cx, "\"abcdefghijklmnopqrstuvwxyz", 1, 28));
+
   CHECK(Error(cx, "\n\"bad string\n\"", 2, 12));
   CHECK(Error(cx, "\r\"bad string\r\"", 2, 12));
   CHECK(Error(cx, "\r\n\"bad string\r\n\"", 2, 12));
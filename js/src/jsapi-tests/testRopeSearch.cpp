@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/tests.h"
+#include "vm/JSContext.h"
+
+BEGIN_TEST(testRopeSearch) {
+  EXEC(
+      "var b40 = 'bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb';"
+      "function makeRope() {"
+      "  var s = 'a'.repeat(100);"
+      "  for (var i = 0; i < 50; i++) s += b40 + i;"
+      "  return s;"
+      "}"
+      "var s = makeRope();"
+      "var t = makeRope();"
+      "var spanning = 'a'.repeat(100) + b40 + '0b';");
+
+  // Flatten the search string up front so that only the searched ropes are
+  // counted below.
+  JS::RootedValue v(cx);
+  EVAL("spanning", &v);
+  CHECK(JS_EnsureLinearString(cx, v.toString()));
+
+  // Searching a rope shouldn't flatten it when the match can be found within
+  // its leaves.
+  cx->ropeFlattenStats.ref().emplace();
+
+  EVAL(
+      "s.startsWith('aaaa') && s.endsWith('49') && !s.startsWith('b') &&"
+      "s.includes('b9') && s.indexOf('bbb') === 100 &&"
+      "s.indexOf('0bbb') === 140 && s.indexOf('b1bb') === 180",
+      &v);
+  CHECK(v.isTrue());
+  CHECK_EQUAL(cx->ropeFlattenStats.ref()->count, 0u);
+
+  // A miss searches the whole rope, and then flattens it so that later
+  // searches are linear.
+  EVAL("!s.includes('zz') && s.includes('b9') && !s.includes('zz')", &v);
+  CHECK(v.isTrue());
+  CHECK_EQUAL(cx->ropeFlattenStats.ref()->count, 1u);
+
+  // A startsWith range that spans several leaves still flattens.
+  EVAL("t.startsWith(spanning)", &v);
+  CHECK(v.isTrue());
+  CHECK_EQUAL(cx->ropeFlattenStats.ref()->count, 2u);
+  CHECK(cx->ropeFlattenStats.ref()->bytesCopied > 0);
+
+  cx->ropeFlattenStats.ref().reset();
+  return true;
+}
+END_TEST(testRopeSearch)
@@ -5,6 +5,10 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "mozilla/IntegerRange.h"
+#include "mozilla/TimeStamp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "js/Vector.h"
 #include "jsapi-tests/tests.h"
@@ -70,3 +74,80 @@ BEGIN_TEST(testSharedImmutableStringsCache) {
   return true;
 }
 END_TEST(testSharedImmutableStringsCache)
+
+// Drive the cache from several threads looking up a larger set of strings that
+// spread across its shards. The strings are already in the cache, which is the
+// common case when many scripts from the same sources load at once.
+
+const int NUM_CONTENTION_THREADS = 16;
+const int NUM_CONTENTION_ITERATIONS = 20000;
+const int NUM_CONTENTION_STRINGS = 256;
+
+struct ContentionStrings {
+  js::SharedImmutableStringsCache* cache;
+  char strings[NUM_CONTENTION_STRINGS][32];
+};
+
+static void lookUpStrings(ContentionStrings* data) {
+  for (int i = 0; i < NUM_CONTENTION_ITERATIONS; i++) {
+    const char* str = data->strings[i % NUM_CONTENTION_STRINGS];
+    size_t length = strlen(str);
+
+    auto deduped = data->cache->getOrCreate(str, length);
+    MOZ_RELEASE_ASSERT(deduped);
+    MOZ_RELEASE_ASSERT(deduped.length() == length);
+    MOZ_RELEASE_ASSERT(memcmp(deduped.chars(), str, length) == 0);
+
+    auto cloned = deduped.clone();
+    MOZ_RELEASE_ASSERT(deduped.chars() == cloned.chars());
+  }
+}
+
+BEGIN_TEST(testSharedImmutableStringsCacheContention) {
+  auto& cache = js::SharedImmutableStringsCache::getSingleton();
+
+  ContentionStrings data;
+  data.cache = &cache;
+
+  // Hold a reference to each string for the duration of the test.
+  js::Vector<js::SharedImmutableString> held(cx);
+  CHECK(held.reserve(NUM_CONTENTION_STRINGS));
+  for (int i = 0; i < NUM_CONTENTION_STRINGS; i++) {
+    snprintf(data.strings[i], sizeof(data.strings[i]), "contention-%d", i);
+    auto str = cache.getOrCreate(data.strings[i], strlen(data.strings[i]));
+    CHECK(str);
+    held.infallibleAppend(std::move(str));
+  }
+
+  js::Vector<js::Thread> threads(cx);
+  CHECK(threads.reserve(NUM_CONTENTION_THREADS));
+
+  mozilla::TimeStamp start = mozilla::TimeStamp::Now();
+
+  for (int i = 0; i < NUM_CONTENTION_THREADS; i++) {
+    threads.infallibleEmplaceBack();
+    CHECK(threads.back().init(lookUpStrings, &data));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Timing is only useful when comparing builds by hand, so keep it out of
+  // the normal test output.
+  if (getenv("JSAPI_TESTS_REPORT_TIMING")) {
+    double ms = (mozilla::TimeStamp::Now() - start).ToMilliseconds();
+    fprintf(stderr, "%d threads x %d lookups: %.1f ms\n",
+            NUM_CONTENTION_THREADS, NUM_CONTENTION_ITERATIONS, ms);
+  }
+
+  // Every lookup should have found the entries we're holding.
+  for (int i = 0; i < NUM_CONTENTION_STRINGS; i++) {
+    auto str = cache.getOrCreate(data.strings[i], strlen(data.strings[i]));
+    CHECK(str);
+    CHECK(str.chars() == held[i].chars());
+  }
+
+  return true;
+}
+END_TEST(testSharedImmutableStringsCacheContention)
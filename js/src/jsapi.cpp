@@ -39,6 +39,8 @@
 #include "gc/GCContext.h"
 #include "gc/Marking.h"
 #include "gc/PublicIterators.h"
+#include "jit/JitHints.h"
+#include "jit/JitRuntime.h"
 #include "jit/JitSpewer.h"
 #include "js/CallAndConstruct.h"  // JS::IsCallable
 #include "js/CharacterEncoding.h"
@@ -4427,6 +4429,38 @@ JS_PUBLIC_API void JS::DisableSpectreMitigationsAfterInit() {
   jit::JitOptions.spectreJitToCxxCalls = false;
 }
 
+static jit::JitHintsMap* GetJitHintsMap(JSContext* cx) {
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime() || !rt->jitRuntime()->hasJitHintsMap()) {
+    return nullptr;
+  }
+  return rt->jitRuntime()->getJitHintsMap();
+}
+
+JS_PUBLIC_API bool JS::EncodeJitHints(JSContext* cx,
+                                      mozilla::Vector<uint8_t>& buffer) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  // With hints disabled there are none to encode, but the result must still
+  // be valid to decode.
+  jit::JitHintsMap emptyHints;
+  jit::JitHintsMap* hints = GetJitHintsMap(cx);
+  return (hints ? hints : &emptyHints)->encode(buffer);
+}
+
+JS_PUBLIC_API bool JS::DecodeJitHints(JSContext* cx, const uint8_t* data,
+                                      size_t length) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  jit::JitHintsMap* hints = GetJitHintsMap(cx);
+  if (!hints) {
+    return true;
+  }
+  return hints->decode(data, length);
+}
+
 /************************************************************************/
 
 #if !defined(STATIC_EXPORTABLE_JS_API) && !defined(STATIC_JS_API) && \
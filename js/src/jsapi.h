@@ -866,6 +866,22 @@ namespace JS {
 // JSContext. Must be called on this context's thread.
 extern JS_PUBLIC_API void DisableSpectreMitigationsAfterInit();
 
+// The JIT records hints about which scripts reached the Baseline and Ion
+// tiers, keyed by script filename and source position, so that they can be
+// compiled eagerly when they are loaded again. EncodeJitHints appends this
+// runtime's hints to |buffer|, and DecodeJitHints adds hints from such a
+// buffer to this runtime, so that a new runtime (for example, in a new
+// process) can skip warmup for scripts that were hot elsewhere. Buffers must
+// only be decoded by the same build that encoded them.
+//
+// Neither function reports an exception. DecodeJitHints returns false if the
+// buffer is invalid or on OOM (which may leave some of its hints added), and
+// ignores the buffer if JIT hints are disabled.
+extern JS_PUBLIC_API bool EncodeJitHints(JSContext* cx,
+                                         mozilla::Vector<uint8_t>& buffer);
+extern JS_PUBLIC_API bool DecodeJitHints(JSContext* cx, const uint8_t* data,
+                                         size_t length);
+
 };  // namespace JS
 
 /**
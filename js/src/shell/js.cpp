@@ -17,6 +17,7 @@
 #include "mozilla/RandomNum.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/ScopeExit.h"
+#include "mozilla/SHA1.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtrExtensions.h"  // UniqueFreePtr
@@ -201,6 +202,7 @@
 #include "vm/ToSource.h"  // js::ValueToSource
 #include "vm/TypedArrayObject.h"
 #include "vm/WrapperObject.h"
+#include "wasm/WasmCompileArgs.h"
 #include "wasm/WasmFeatures.h"
 #include "wasm/WasmJS.h"
 
@@ -227,6 +229,7 @@ using mozilla::MakeScopeExit;
 using mozilla::Maybe;
 using mozilla::Nothing;
 using mozilla::NumberEqualsInt32;
+using mozilla::SHA1Sum;
 using mozilla::TimeDuration;
 using mozilla::TimeStamp;
 using mozilla::Utf8Unit;
@@ -594,6 +597,8 @@ struct MOZ_STACK_CLASS EnvironmentPreparer
 };
 
 const char* shell::selfHostedXDRPath = nullptr;
+const char* shell::wasmCodeCacheDir = nullptr;
+const char* shell::jitHintsPath = nullptr;
 bool shell::encodeSelfHostedCode = false;
 bool shell::enableCodeCoverage = false;
 bool shell::enableDisassemblyDumps = false;
@@ -7541,6 +7546,170 @@ static bool SetSharedObject(JSContext* cx, unsigned argc, Value* vp) {
 
 typedef Vector<uint8_t, 0, SystemAllocPolicy> Uint8Vector;
 
+// Return the path of the --wasm-code-cache-dir file for the given bytecode.
+// The file name is a hash of the bytecode, of the optimized encoding build id
+// and of the current wasm compile args, so that code from a different build or
+// CPU, or compiled with different tiers or features enabled, is never loaded.
+static UniqueChars WasmCodeCachePath(JSContext* cx, const uint8_t* bytes,
+                                     size_t length) {
+  MOZ_ASSERT(wasmCodeCacheDir);
+
+  JS::BuildIdCharVector buildId;
+  if (!JS::GetOptimizedEncodingBuildId(&buildId)) {
+    JS_ReportOutOfMemory(cx);
+    return nullptr;
+  }
+
+  wasm::SharedCompileArgs compileArgs = wasm::CompileArgs::buildAndReport(
+      cx, wasm::ScriptedCaller(), wasm::FeatureOptions(),
+      /* reportOOM = */ true);
+  if (!compileArgs) {
+    return nullptr;
+  }
+
+  const wasm::FeatureArgs& features = compileArgs->features;
+  const uint8_t flags[] = {
+      compileArgs->baselineEnabled,
+      compileArgs->ionEnabled,
+      compileArgs->debugEnabled,
+      compileArgs->forceTiering,
+#define WASM_FEATURE(NAME, LOWER_NAME, ...) features.LOWER_NAME,
+      JS_FOR_WASM_FEATURES(WASM_FEATURE)
+#undef WASM_FEATURE
+      features.sharedMemory == wasm::Shareable::True,
+      features.simd,
+      features.intrinsics,
+  };
+
+  SHA1Sum sum;
+  sum.update(buildId.begin(), buildId.length());
+  sum.update(flags, sizeof(flags));
+  sum.update(bytes, length);
+  SHA1Sum::Hash hash;
+  sum.finish(hash);
+
+  char hex[2 * sizeof(hash) + 1];
+  for (size_t i = 0; i < sizeof(hash); i++) {
+    SprintfBuf(hex + 2 * i, 3, "%02x", hash[i]);
+  }
+
+  UniqueChars path = JS_smprintf("%s/%s.wasmcode", wasmCodeCacheDir, hex);
+  if (!path) {
+    JS_ReportOutOfMemory(cx);
+  }
+  return path;
+}
+
+static bool ReadCacheFile(const char* path, Uint8Vector* bytes) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  AutoCloseFile autoClose(file);
+
+  struct stat st;
+  if (fstat(fileno(file), &st) < 0 || st.st_size <= 0) {
+    return false;
+  }
+
+  if (!bytes->resize(size_t(st.st_size))) {
+    return false;
+  }
+
+  return fread(bytes->begin(), 1, bytes->length(), file) == bytes->length();
+}
+
+static void WriteCacheFile(const char* path, const uint8_t* bytes,
+                           size_t length) {
+  // Write to a temporary file and rename it into place, so that a concurrent
+  // or interrupted run never sees a partially written entry.
+  UniqueChars tmpPath = JS_smprintf("%s.%" PRIx64 ".tmp", path,
+                                    mozilla::RandomUint64OrDie());
+  if (!tmpPath) {
+    return;
+  }
+
+  FILE* file = fopen(tmpPath.get(), "wb");
+  if (!file) {
+    return;
+  }
+
+  bool ok = fwrite(bytes, 1, length, file) == length;
+  ok = fclose(file) == 0 && ok;
+  if (!ok || rename(tmpPath.get(), path) != 0) {
+    remove(tmpPath.get());
+  }
+}
+
+// Files in the --wasm-code-cache-dir start with this header. The optimized
+// encoding is only ever deserialized after the header has been checked,
+// because Module::deserialize trusts its input and crashes on truncated or
+// corrupted bytes.
+struct WasmCodeCacheHeader {
+  static constexpr char MagicValue[8] = {'S', 'M', 'W', 'A',
+                                         'S', 'M', 'C', '1'};
+
+  char magic[8];
+  uint64_t payloadLength;
+  SHA1Sum::Hash checksum;
+};
+
+static void ComputeWasmCodeCacheChecksum(const uint8_t* bytes, size_t length,
+                                         SHA1Sum::Hash& hash) {
+  SHA1Sum sum;
+  sum.update(bytes, length);
+  sum.finish(hash);
+}
+
+static void WriteWasmCodeCacheFile(const char* path, const uint8_t* bytes,
+                                   size_t length) {
+  WasmCodeCacheHeader header;
+  memcpy(header.magic, WasmCodeCacheHeader::MagicValue, sizeof(header.magic));
+  header.payloadLength = length;
+  ComputeWasmCodeCacheChecksum(bytes, length, header.checksum);
+
+  Uint8Vector file;
+  if (!file.append(reinterpret_cast<const uint8_t*>(&header),
+                   sizeof(header)) ||
+      !file.append(bytes, length)) {
+    return;
+  }
+
+  WriteCacheFile(path, file.begin(), file.length());
+}
+
+// Read the optimized encoding stored in a --wasm-code-cache-dir file. If the
+// file exists but is truncated or corrupt it is removed, so that the caller
+// compiles the bytecode and stores a fresh copy.
+static bool ReadWasmCodeCacheFile(const char* path, Uint8Vector* payload) {
+  Uint8Vector file;
+  if (!ReadCacheFile(path, &file)) {
+    return false;
+  }
+
+  WasmCodeCacheHeader header;
+  bool valid = file.length() >= sizeof(header);
+  if (valid) {
+    memcpy(&header, file.begin(), sizeof(header));
+    valid = memcmp(header.magic, WasmCodeCacheHeader::MagicValue,
+                   sizeof(header.magic)) == 0 &&
+            header.payloadLength > 0 &&
+            header.payloadLength == file.length() - sizeof(header);
+  }
+  if (valid) {
+    SHA1Sum::Hash checksum;
+    ComputeWasmCodeCacheChecksum(file.begin() + sizeof(header),
+                                 header.payloadLength, checksum);
+    valid = memcmp(checksum, header.checksum, sizeof(checksum)) == 0;
+  }
+  if (!valid) {
+    remove(path);
+    return false;
+  }
+
+  return payload->append(file.begin() + sizeof(header), header.payloadLength);
+}
+
 class StreamCacheEntry : public AtomicRefCounted<StreamCacheEntry>,
                          public JS::OptimizedEncodingListener {
   typedef AtomicRefCounted<StreamCacheEntry> AtomicBase;
@@ -7548,10 +7717,16 @@ class StreamCacheEntry : public AtomicRefCounted<StreamCacheEntry>,
   Uint8Vector bytes_;
   ExclusiveData<Uint8Vector> optimized_;
 
+  // If set, optimized encodings are also written to this file. See
+  // --wasm-code-cache-dir.
+  UniqueChars diskCachePath_;
+
  public:
-  explicit StreamCacheEntry(Uint8Vector&& original)
+  explicit StreamCacheEntry(Uint8Vector&& original,
+                            UniqueChars diskCachePath = nullptr)
       : bytes_(std::move(original)),
-        optimized_(mutexid::ShellStreamCacheEntryState) {}
+        optimized_(mutexid::ShellStreamCacheEntryState),
+        diskCachePath_(std::move(diskCachePath)) {}
 
   // Implement JS::OptimizedEncodingListener:
 
@@ -7581,6 +7756,21 @@ class StreamCacheEntry : public AtomicRefCounted<StreamCacheEntry>,
       return;
     }
     memcpy(dstBytes->begin(), srcBytes, srcLength);
+
+    if (diskCachePath_) {
+      WriteWasmCodeCacheFile(diskCachePath_.get(), srcBytes, srcLength);
+    }
+  }
+
+  // Load a previously stored optimized encoding from the disk cache, if
+  // there is a valid one. Otherwise the bytecode is compiled as usual and the
+  // result is stored back to the disk cache.
+  void loadFromDiskCache() {
+    MOZ_ASSERT(diskCachePath_);
+    Uint8Vector cached;
+    if (ReadWasmCodeCacheFile(diskCachePath_.get(), &cached)) {
+      *optimized_.lock() = std::move(cached);
+    }
   }
 
   bool hasOptimizedEncoding() const { return !optimized_.lock()->empty(); }
@@ -7845,7 +8035,24 @@ static bool ConsumeBufferSource(JSContext* cx, JS::HandleObject obj,
     }
 
     memcpy(bytes.begin(), dataPointer.unwrap(), byteLength);
-    job = cx->make_unique<BufferStreamJob>(std::move(bytes), consumer);
+
+    if (wasmCodeCacheDir) {
+      // Route the compilation through a cache entry that is backed by a file
+      // in the code cache directory.
+      UniqueChars path = WasmCodeCachePath(cx, bytes.begin(), bytes.length());
+      if (!path) {
+        return false;
+      }
+      RefPtr<StreamCacheEntry> cache =
+          cx->new_<StreamCacheEntry>(std::move(bytes), std::move(path));
+      if (!cache) {
+        return false;
+      }
+      cache->loadFromDiskCache();
+      job = cx->make_unique<BufferStreamJob>(*cache, consumer);
+    } else {
+      job = cx->make_unique<BufferStreamJob>(std::move(bytes), consumer);
+    }
   } else if (obj->is<StreamCacheEntryObject>()) {
     job = cx->make_unique<BufferStreamJob>(
         obj->as<StreamCacheEntryObject>().cache(), consumer);
@@ -11128,6 +11335,30 @@ static bool WriteSelfHostedXDRFile(JSContext* cx, JS::SelfHostedCache buffer) {
   return true;
 }
 
+// Add the JIT hints saved by an earlier run with the same --jit-hints-file.
+static void LoadJitHintsFile(JSContext* cx) {
+  Uint8Vector bytes;
+  if (!ReadCacheFile(jitHintsPath, &bytes)) {
+    // Nothing has been saved yet.
+    return;
+  }
+
+  if (!JS::DecodeJitHints(cx, bytes.begin(), bytes.length())) {
+    fprintf(stderr, "Ignoring invalid JIT hints file %s.\n", jitHintsPath);
+  }
+}
+
+// Save the JIT hints recorded by this run, including those loaded at startup.
+static void SaveJitHintsFile(JSContext* cx) {
+  mozilla::Vector<uint8_t> bytes;
+  if (!JS::EncodeJitHints(cx, bytes)) {
+    fprintf(stderr, "Out of memory encoding JIT hints.\n");
+    return;
+  }
+
+  WriteCacheFile(jitHintsPath, bytes.begin(), bytes.length());
+}
+
 static bool SetGCParameterFromArg(JSContext* cx, char* arg) {
   char* c = strchr(arg, '=');
   if (!c) {
@@ -11389,8 +11620,16 @@ int main(int argc, char** argv) {
     return EXIT_SUCCESS;
   }
 
+  if (jitHintsPath) {
+    LoadJitHintsFile(cx);
+  }
+
   result = Shell(cx, &op);
 
+  if (jitHintsPath) {
+    SaveJitHintsFile(cx);
+  }
+
 #ifdef DEBUG
   if (OOM_printAllocationCount) {
     printf("OOM max count: %" PRIu64 "\n", js::oom::simulator.counter());
@@ -11484,6 +11723,10 @@ bool InitOptionParser(OptionParser& op) {
           "'baseline+ion', 'baseline+optimizing'.") ||
       !op.addBoolOption('\0', "wasm-verbose",
                         "Enable WebAssembly verbose logging") ||
+      !op.addStringOption('\0', "wasm-code-cache-dir", "[directory]",
+                          "Store the optimized code of streamed wasm modules "
+                          "in the given directory, keyed by a hash of the "
+                          "bytecode, and reuse it on later runs") ||
       !op.addBoolOption('\0', "disable-wasm-huge-memory",
                         "Disable WebAssembly huge memory") ||
       !op.addBoolOption('\0', "test-wasm-await-tier2",
@@ -11657,6 +11900,10 @@ bool InitOptionParser(OptionParser& op) {
       !op.addBoolOption('\0', "no-blinterp", "Disable Baseline Interpreter") ||
       !op.addBoolOption('\0', "disable-jithints",
                         "Disable caching eager baseline compilation hints.") ||
+      !op.addStringOption('\0', "jit-hints-file", "[path]",
+                          "Load eager compilation hints from the given file "
+                          "at startup and save the hints recorded by this run "
+                          "to it at exit") ||
       !op.addBoolOption(
           '\0', "emit-interpreter-entry",
           "Emit Interpreter entry trampolines (default under --enable-perf)") ||
@@ -12155,6 +12402,7 @@ bool SetContextWasmOptions(JSContext* cx, const OptionParser& op) {
 #undef WASM_FEATURE
 
   enableWasmVerbose = op.getBoolOption("wasm-verbose");
+  wasmCodeCacheDir = op.getStringOption("wasm-code-cache-dir");
   enableTestWasmAwaitTier2 = op.getBoolOption("test-wasm-await-tier2");
 
   JS::ContextOptionsRef(cx)
@@ -12458,6 +12706,8 @@ bool SetContextJITOptions(JSContext* cx, const OptionParser& op) {
     jit::JitOptions.disableJitHints = true;
   }
 
+  jitHintsPath = op.getStringOption("jit-hints-file");
+
   if (op.getBoolOption("emit-interpreter-entry")) {
     jit::JitOptions.emitInterpreterEntryTrampoline = true;
   }
@@ -102,6 +102,8 @@ extern char** sArgv;
 
 // Shell state set once at startup.
 extern const char* selfHostedXDRPath;
+extern const char* wasmCodeCacheDir;
+extern const char* jitHintsPath;
 extern bool encodeSelfHostedCode;
 extern bool enableCodeCoverage;
 extern bool enableDisassemblyDumps;
@@ -0,0 +1,56 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures how long the frontend takes to parse a script, without running it.
+//
+// Usage:
+//
+//   js parse-bench.js [file [runs]]
+//
+// With no file, a synthetic minified-style bundle is generated. Run this with
+// an optimized (non-DEBUG) shell: DEBUG builds dump the parse tree.
+//
+// parse() tokenizes ASCII source as UTF-8 and anything else as UTF-16, so the
+// source is parsed as-is and again with a non-ASCII comment appended, to cover
+// both tokenizers. syntaxParse() always uses UTF-16 and does a syntax-only
+// parse, whose time is dominated by tokenizing.
+
+const file = scriptArgs[0];
+const runs = Number(scriptArgs[1] ?? 10);
+
+function makeBundle() {
+  let parts = [];
+  for (let i = 0; i < 20000; i++) {
+    parts.push(
+      `function f${i}(a,b){// helper ${i} for the generated bundle\n` +
+      `var s="string literal number ${i} with some length to it";` +
+      `var t=\`template ${i} \${a} and \${b} end\`;` +
+      `return a.someLongPropertyName${i}+b.anotherLongPropertyName+s+t}`);
+  }
+  return parts.join("\n");
+}
+
+const source = file ? os.file.readFile(file) : makeBundle();
+
+function median(f) {
+  let times = [];
+  for (let i = 0; i < runs; i++) {
+    let start = monotonicNow();
+    f();
+    times.push(monotonicNow() - start);
+  }
+  times.sort((a, b) => a - b);
+  return times[times.length >> 1];
+}
+
+function report(label, text) {
+  let full = median(() => parse(text));
+  print(`${label}: full parse ${full.toFixed(1)} ms`);
+}
+
+print(`source: ${source.length} characters, ${runs} runs`);
+report("utf-8      ", source);
+report("utf-16     ", source + "\n// \u2603");
+let syntax = median(() => syntaxParse(source));
+print(`syntax-only: ${syntax.toFixed(1)} ms`);
@@ -0,0 +1,65 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures Array.prototype.sort and %TypedArray%.prototype.sort on arrays that
+// are large enough to be sorted on helper threads (see vm/ParallelSort.h).
+//
+// Usage:
+//
+//   js sort-bench.js [length [runs]]
+//
+// Compare against the sequential sort by running the same shell with
+// --no-threads. The "helper" column is how many sort steps helper threads
+// picked up; the rest ran on the main thread.
+
+const length = Number(scriptArgs[0] ?? 1000000);
+const runs = Number(scriptArgs[1] ?? 10);
+
+let seed = 1;
+function random() {
+  // A fixed sequence, so that every run sorts the same input.
+  seed = (seed * 1103515245 + 12345) % 2147483648;
+  return seed / 2147483648;
+}
+
+function makeInt32s() {
+  return Array.from({length}, () => (random() * 2 ** 32) | 0);
+}
+
+function makeDoubles() {
+  return Array.from({length}, () => (random() - 0.5) * 1e6);
+}
+
+function makeStrings() {
+  return Array.from({length}, () => "key" + Math.floor(random() * 1e9));
+}
+
+function median(make, sort) {
+  let times = [];
+  for (let i = 0; i < runs; i++) {
+    let input = make();
+    let start = monotonicNow();
+    sort(input);
+    times.push(monotonicNow() - start);
+  }
+  times.sort((a, b) => a - b);
+  return times[times.length >> 1];
+}
+
+function report(label, make, sort) {
+  helperThreadWaitTimes(/* reset = */ true);
+  let time = median(make, sort);
+  let helper = helperThreadWaitTimes(/* reset = */ true).parallelSort;
+  print(`${label}: ${time.toFixed(1)} ms, helper ${helper ? helper.count : 0}`);
+}
+
+print(`length: ${length}, ${runs} runs`);
+report("Int32 default      ", makeInt32s, a => a.sort());
+report("Int32 a - b        ", makeInt32s, a => a.sort((x, y) => x - y));
+report("Float64 a - b      ", makeDoubles, a => a.sort((x, y) => x - y));
+report("strings            ", makeStrings, a => a.sort());
+report("Int32Array         ", () => new Int32Array(makeInt32s()),
+       a => a.sort());
+report("Float64Array       ", () => new Float64Array(makeDoubles()),
+       a => a.sort());
@@ -0,0 +1,71 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures how long it takes to instantiate a wasm module that arrives over a
+// slow stream, using the shell's simulated streaming (setBufferStreamParams).
+//
+// Usage:
+//
+//   js wasm-streaming-bench.js [numFuncs [delayMillis [chunkSize [runs]]]]
+//
+// The module is synthetic: |numFuncs| functions with moderately sized bodies,
+// enough to span many compile batches. Reported times are from the start of
+// WebAssembly.instantiateStreaming to the resolution of its promise; the
+// "transfer" time is the minimum the stream itself takes, so the difference is
+// the compilation work that didn't overlap the download.
+
+if (!wasmStreamingEnabled()) {
+  print("wasm streaming is not enabled in this shell");
+  quit(0);
+}
+
+const numFuncs = Number(scriptArgs[0] ?? 2000);
+const delayMillis = Number(scriptArgs[1] ?? 1);
+const chunkSize = Number(scriptArgs[2] ?? 4096);
+const runs = Number(scriptArgs[3] ?? 5);
+
+function makeModule(n) {
+  let funcs = [];
+  for (let i = 0; i < n; i++) {
+    let body = "(local.get 0)";
+    for (let j = 0; j < 32; j++) {
+      body = `(i32.add (i32.mul ${body} (i32.const ${i + j})) (local.get 0))`;
+    }
+    funcs.push(`(func (export "f${i}") (param i32) (result i32) ${body})`);
+  }
+  return wasmTextToBinary(`(module ${funcs.join("\n")})`);
+}
+
+const bytes = makeModule(numFuncs);
+const transferMillis = Math.ceil(bytes.byteLength / chunkSize) * delayMillis;
+
+setBufferStreamParams(delayMillis, chunkSize);
+
+print(`module: ${bytes.byteLength} bytes, ${numFuncs} functions`);
+print(`stream: ${chunkSize} byte chunks every ${delayMillis} ms ` +
+      `(>= ${transferMillis} ms transfer)`);
+print(`compile mode: ${wasmCompileMode()}`);
+
+let times = [];
+for (let i = 0; i < runs; i++) {
+  let start = monotonicNow();
+  let elapsed, error;
+  WebAssembly.instantiateStreaming(bytes).then(
+    () => { elapsed = monotonicNow() - start; },
+    e => { error = e; });
+  drainJobQueue();
+  if (error) {
+    throw error;
+  }
+  if (elapsed === undefined) {
+    throw new Error("instantiateStreaming did not settle");
+  }
+  times.push(elapsed);
+  print(`run ${i}: ${elapsed.toFixed(1)} ms to instantiate`);
+}
+
+times.sort((a, b) => a - b);
+const median = times[times.length >> 1];
+print(`median: ${median.toFixed(1)} ms, ` +
+      `${(median - transferMillis).toFixed(1)} ms after transfer`);
@@ -223,6 +223,9 @@ void* js::MapBufferMemory(wasm::IndexType t, size_t mappedSize,
     munmap(data, mappedSize);
     return nullptr;
   }
+
+  // Memory committed later by CommitBufferMemory inherits this advice.
+  gc::MarkPagesHuge(data, mappedSize);
 #endif  // !XP_WIN && !__wasi__
 
 #if defined(MOZ_VALGRIND) && \
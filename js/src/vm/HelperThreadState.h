@@ -59,6 +59,7 @@ struct ParseTask;
 struct DelazifyTask;
 struct FreeDelazifyTask;
 struct PromiseHelperTask;
+class ParallelSortTask;
 class PromiseObject;
 
 namespace jit {
@@ -128,12 +129,21 @@ class GlobalHelperThreadState {
       SourceCompressionTaskVector;
   typedef Vector<PromiseHelperTask*, 0, SystemAllocPolicy>
       PromiseHelperTaskVector;
+  using ParallelSortTaskList = mozilla::LinkedList<ParallelSortTask>;
 
   // Count of running task by each threadType.
   mozilla::EnumeratedArray<ThreadType, ThreadType::THREAD_TYPE_MAX, size_t>
       runningTaskCount;
   size_t totalCountRunningTasks;
 
+  // How long tasks of a given threadType waited between being queued and
+  // starting to run on a helper thread.
+  struct TaskWaitStats {
+    size_t count = 0;
+    mozilla::TimeDuration total;
+    mozilla::TimeDuration max;
+  };
+
   WriteOnceData<JS::RegisterThreadCallback> registerThread;
   WriteOnceData<JS::UnregisterThreadCallback> unregisterThread;
 
@@ -186,6 +196,9 @@ class GlobalHelperThreadState {
   GCParallelTaskList gcParallelWorklist_;
   size_t gcParallelThreadCount;
 
+  // Steps of array sorts that the main thread is waiting for.
+  ParallelSortTaskList parallelSortWorklist_;
+
   using HelperThreadTaskVector =
       Vector<HelperThreadTask*, 0, SystemAllocPolicy>;
   // Vector of running HelperThreadTask.
@@ -197,10 +210,18 @@ class GlobalHelperThreadState {
   // pool is used.
   JS::HelperThreadTaskCallback dispatchTaskCallback = nullptr;
 
+  // Callback called before each queued task runs. Set by
+  // JS::SetHelperThreadTaskStartCallback.
+  JS::HelperThreadTaskStartCallback taskStartCallback = nullptr;
+
   // The number of tasks dispatched to the thread pool that have not started
   // running yet.
   size_t tasksPending_ = 0;
 
+  mozilla::EnumeratedArray<ThreadType, ThreadType::THREAD_TYPE_MAX,
+                           TaskWaitStats>
+      taskWaitStats_;
+
   bool isInitialized_ = false;
 
   bool useInternalThreadPool_ = true;
@@ -218,6 +239,7 @@ class GlobalHelperThreadState {
   size_t maxParseThreads() const;
   size_t maxCompressionThreads() const;
   size_t maxGCParallelThreads(const AutoLockHelperThreadState& lock) const;
+  size_t maxParallelSortThreads() const;
 
   GlobalHelperThreadState();
 
@@ -255,6 +277,21 @@ class GlobalHelperThreadState {
     return terminating_;
   }
 
+  const TaskWaitStats& taskWaitStats(ThreadType threadType,
+                                     const AutoLockHelperThreadState&) const {
+    return taskWaitStats_[threadType];
+  }
+  void resetTaskWaitStats(const AutoLockHelperThreadState&) {
+    for (auto& stats : taskWaitStats_) {
+      stats = TaskWaitStats();
+    }
+  }
+
+  void setTaskStartCallback(JS::HelperThreadTaskStartCallback callback,
+                            const AutoLockHelperThreadState&) {
+    taskStartCallback = callback;
+  }
+
  private:
   void notifyOne(const AutoLockHelperThreadState&);
 
@@ -345,6 +382,10 @@ class GlobalHelperThreadState {
 
   GCParallelTaskList& gcParallelWorklist() { return gcParallelWorklist_; }
 
+  ParallelSortTaskList& parallelSortWorklist(const AutoLockHelperThreadState&) {
+    return parallelSortWorklist_;
+  }
+
   size_t getGCParallelThreadCount(const AutoLockHelperThreadState& lock) const {
     return gcParallelThreadCount;
   }
@@ -373,6 +414,7 @@ class GlobalHelperThreadState {
   bool canStartDelazifyTask(const AutoLockHelperThreadState& lock);
   bool canStartCompressionTask(const AutoLockHelperThreadState& lock);
   bool canStartGCParallelTask(const AutoLockHelperThreadState& lock);
+  bool canStartParallelSortTask(const AutoLockHelperThreadState& lock);
 
   HelperThreadTask* maybeGetWasmCompile(const AutoLockHelperThreadState& lock,
                                         wasm::CompileMode mode);
@@ -398,6 +440,8 @@ class GlobalHelperThreadState {
       const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetGCParallelTask(
       const AutoLockHelperThreadState& lock);
+  HelperThreadTask* maybeGetParallelSortTask(
+      const AutoLockHelperThreadState& lock);
 
   enum class ScheduleCompressionTask { GC, API };
 
@@ -466,6 +510,8 @@ class GlobalHelperThreadState {
   bool submitTask(PromiseHelperTask* task);
   bool submitTask(GCParallelTask* task,
                   const AutoLockHelperThreadState& locked);
+  void submitTask(ParallelSortTask* task,
+                  const AutoLockHelperThreadState& locked);
   void runOneTask(AutoLockHelperThreadState& lock);
   void runTaskLocked(HelperThreadTask* task, AutoLockHelperThreadState& lock);
 
@@ -701,6 +747,40 @@ struct PromiseHelperTask : OffThreadPromiseTask, public HelperThreadTask {
   ThreadType threadType() override { return THREAD_TYPE_PROMISE_TASK; }
 };
 
+// A single step of a ParallelSort (see vm/ParallelSort.h). The main thread
+// starts some steps and then joins them. A step that no helper thread has
+// picked up by then is run on the main thread instead of waiting for one.
+//
+// Concrete subclasses must implement runStep and call join() from their
+// destructor.
+class ParallelSortTask : public mozilla::LinkedListElement<ParallelSortTask>,
+                         public HelperThreadTask {
+  enum class State { Idle, Dispatched, Running, Finished };
+
+  // Protected by the helper thread lock.
+  State state_ = State::Idle;
+
+  bool ok_ = false;
+
+ protected:
+  // Do the work. This may run on a helper thread, so it must not use a
+  // JSContext or touch GC things. Returns false on failure.
+  virtual bool runStep() = 0;
+
+ public:
+  ParallelSortTask() = default;
+  ~ParallelSortTask() override;
+
+  // Whether the step succeeded. Only valid after join().
+  bool ok() const { return ok_; }
+
+  void start();
+  void join();
+
+  void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
+  ThreadType threadType() override { return THREAD_TYPE_PARALLEL_SORT; }
+};
+
 } /* namespace js */
 
 #endif /* vm_HelperThreadState_h */
@@ -18,6 +18,7 @@ struct ParseTask;
 struct DelazifyTask;
 struct FreeDelazifyTask;
 class SourceCompressionTask;
+class ParallelSortTask;
 
 namespace jit {
 class IonCompileTask;
@@ -60,11 +61,21 @@ struct MapTypeToThreadType<SourceCompressionTask> {
   static const ThreadType threadType = THREAD_TYPE_COMPRESS;
 };
 
+template <>
+struct MapTypeToThreadType<ParallelSortTask> {
+  static const ThreadType threadType = THREAD_TYPE_PARALLEL_SORT;
+};
+
 struct HelperThreadTask {
   virtual void runHelperThreadTask(AutoLockHelperThreadState& locked) = 0;
   virtual ThreadType threadType() = 0;
   virtual ~HelperThreadTask() = default;
 
+  // Record when the task was added to a worklist, so that we can measure how
+  // long it waits before a helper thread picks it up.
+  void noteQueued() { queuedTime_ = mozilla::TimeStamp::Now(); }
+  mozilla::TimeStamp queuedTime() const { return queuedTime_; }
+
   template <typename T>
   bool is() {
     return MapTypeToThreadType<T>::threadType == threadType();
@@ -75,6 +86,9 @@ struct HelperThreadTask {
     MOZ_ASSERT(this->is<T>());
     return static_cast<T*>(this);
   }
+
+ private:
+  mozilla::TimeStamp queuedTime_;
 };
 
 }  // namespace js
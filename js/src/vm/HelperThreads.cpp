@@ -139,6 +139,43 @@ JS_PUBLIC_API MOZ_NEVER_INLINE void JS::SetHelperThreadTaskCallback(
                                               lock);
 }
 
+JS_PUBLIC_API void JS::SetHelperThreadTaskStartCallback(
+    HelperThreadTaskStartCallback callback) {
+  AutoLockHelperThreadState lock;
+  HelperThreadState().setTaskStartCallback(callback, lock);
+}
+
+const char* js::HelperThreadTypeName(ThreadType threadType) {
+  switch (threadType) {
+    case THREAD_TYPE_WASM_COMPILE_TIER1:
+      return "wasmCompileTier1";
+    case THREAD_TYPE_WASM_COMPILE_TIER2:
+      return "wasmCompileTier2";
+    case THREAD_TYPE_ION:
+      return "ion";
+    case THREAD_TYPE_PARSE:
+      return "parse";
+    case THREAD_TYPE_COMPRESS:
+      return "compress";
+    case THREAD_TYPE_GCPARALLEL:
+      return "gcParallel";
+    case THREAD_TYPE_PROMISE_TASK:
+      return "promiseTask";
+    case THREAD_TYPE_ION_FREE:
+      return "ionFree";
+    case THREAD_TYPE_WASM_GENERATOR_TIER2:
+      return "wasmGeneratorTier2";
+    case THREAD_TYPE_DELAZIFY:
+      return "delazify";
+    case THREAD_TYPE_DELAZIFY_FREE:
+      return "delazifyFree";
+    case THREAD_TYPE_PARALLEL_SORT:
+      return "parallelSort";
+    default:
+      return nullptr;
+  }
+}
+
 void GlobalHelperThreadState::setDispatchTaskCallback(
     JS::HelperThreadTaskCallback callback, size_t threadCount, size_t stackSize,
     const AutoLockHelperThreadState& lock) {
@@ -163,6 +200,7 @@ bool GlobalHelperThreadState::submitTask(wasm::CompileTask* task,
   if (!wasmWorklist(lock, mode).pushBack(task)) {
     return false;
   }
+  task->noteQueued();
 
   dispatch(DispatchReason::NewTask, lock);
   return true;
@@ -190,6 +228,7 @@ bool GlobalHelperThreadState::submitTask(wasm::UniqueTier2GeneratorTask task) {
   if (!wasmTier2GeneratorWorklist(lock).append(task.get())) {
     return false;
   }
+  task->noteQueued();
   (void)task.release();
 
   dispatch(DispatchReason::NewTask, lock);
@@ -260,6 +299,7 @@ bool GlobalHelperThreadState::submitTask(
   if (!ionWorklist(locked).append(task)) {
     return false;
   }
+  task->noteQueued();
 
   // The build is moving off-thread. Freeze the LifoAlloc to prevent any
   // unwanted mutations.
@@ -284,6 +324,7 @@ bool GlobalHelperThreadState::submitTask(
     UniquePtr<jit::IonFreeTask> task, const AutoLockHelperThreadState& locked) {
   MOZ_ASSERT(isInitialized(locked));
 
+  task->noteQueued();
   if (!ionFreeList(locked).append(std::move(task))) {
     return false;
   }
@@ -998,6 +1039,7 @@ static bool QueueOffThreadParseTask(JSContext* cx, UniquePtr<ParseTask> task) {
 bool GlobalHelperThreadState::submitTask(
     JSRuntime* rt, UniquePtr<ParseTask> task,
     const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
   if (!parseWorklist(locked).append(std::move(task))) {
     return false;
   }
@@ -1008,12 +1050,14 @@ bool GlobalHelperThreadState::submitTask(
 
 void GlobalHelperThreadState::submitTask(
     DelazifyTask* task, const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
   delazifyWorklist(locked).insertBack(task);
   dispatch(DispatchReason::NewTask, locked);
 }
 
 bool GlobalHelperThreadState::submitTask(
     UniquePtr<FreeDelazifyTask> task, const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
   if (!freeDelazifyTaskVector(locked).append(std::move(task))) {
     return false;
   }
@@ -1274,6 +1318,7 @@ void GlobalHelperThreadState::waitForAllTasksLocked(
   }
 
   MOZ_ASSERT(gcParallelWorklist().isEmpty(lock));
+  MOZ_ASSERT(parallelSortWorklist(lock).isEmpty());
   MOZ_ASSERT(ionWorklist(lock).empty());
   MOZ_ASSERT(wasmWorklist(lock, wasm::CompileMode::Tier1).empty());
   MOZ_ASSERT(promiseHelperTasks(lock).empty());
@@ -1464,6 +1509,10 @@ size_t GlobalHelperThreadState::maxGCParallelThreads(
   return gcParallelThreadCount;
 }
 
+size_t GlobalHelperThreadState::maxParallelSortThreads() const {
+  return std::min(cpuCount, threadCount);
+}
+
 HelperThreadTask* GlobalHelperThreadState::maybeGetWasmTier1CompileTask(
     const AutoLockHelperThreadState& lock) {
   return maybeGetWasmCompile(lock, wasm::CompileMode::Tier1);
@@ -1765,6 +1814,7 @@ void GlobalHelperThreadState::startHandlingCompressionTasks(
 bool GlobalHelperThreadState::submitTask(
     UniquePtr<SourceCompressionTask> task,
     const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
   if (!compressionWorklist(locked).append(std::move(task))) {
     return false;
   }
@@ -1775,6 +1825,7 @@ bool GlobalHelperThreadState::submitTask(
 
 bool GlobalHelperThreadState::submitTask(
     GCParallelTask* task, const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
   gcParallelWorklist().insertBack(task, locked);
   dispatch(DispatchReason::NewTask, locked);
   return true;
@@ -1796,6 +1847,80 @@ bool GlobalHelperThreadState::canStartGCParallelTask(
                               maxGCParallelThreads(lock), lock);
 }
 
+void GlobalHelperThreadState::submitTask(
+    ParallelSortTask* task, const AutoLockHelperThreadState& locked) {
+  task->noteQueued();
+  parallelSortWorklist(locked).insertBack(task);
+  dispatch(DispatchReason::NewTask, locked);
+}
+
+HelperThreadTask* GlobalHelperThreadState::maybeGetParallelSortTask(
+    const AutoLockHelperThreadState& lock) {
+  if (!canStartParallelSortTask(lock)) {
+    return nullptr;
+  }
+
+  return parallelSortWorklist(lock).popFirst();
+}
+
+bool GlobalHelperThreadState::canStartParallelSortTask(
+    const AutoLockHelperThreadState& lock) {
+  return !parallelSortWorklist(lock).isEmpty() &&
+         checkTaskThreadLimit(THREAD_TYPE_PARALLEL_SORT,
+                              maxParallelSortThreads(), lock);
+}
+
+ParallelSortTask::~ParallelSortTask() {
+  // Subclasses must join the task before their members are destroyed.
+  MOZ_ASSERT(state_ == State::Idle);
+  MOZ_ASSERT(!isInList());
+}
+
+void ParallelSortTask::start() {
+  MOZ_ASSERT(CanUseExtraThreads());
+
+  AutoLockHelperThreadState lock;
+  MOZ_ASSERT(state_ == State::Idle);
+  state_ = State::Dispatched;
+  HelperThreadState().submitTask(this, lock);
+}
+
+void ParallelSortTask::join() {
+  AutoLockHelperThreadState lock;
+
+  if (state_ == State::Dispatched) {
+    // No helper thread has picked this up yet, so run it here rather than
+    // wait for one.
+    remove();
+    state_ = State::Idle;
+
+    AutoUnlockHelperThreadState unlock(lock);
+    JS::AutoSuppressGCAnalysis nogc;
+    ok_ = runStep();
+    return;
+  }
+
+  while (state_ == State::Running) {
+    HelperThreadState().wait(lock);
+  }
+
+  MOZ_ASSERT(state_ == State::Idle || state_ == State::Finished);
+  state_ = State::Idle;
+}
+
+void ParallelSortTask::runHelperThreadTask(AutoLockHelperThreadState& lock) {
+  MOZ_ASSERT(state_ == State::Dispatched);
+  state_ = State::Running;
+
+  {
+    AutoUnlockHelperThreadState unlock(lock);
+    ok_ = runStep();
+  }
+
+  // runOneTask notifies the waiting main thread.
+  state_ = State::Finished;
+}
+
 ParseTask* GlobalHelperThreadState::removeFinishedParseTask(
     JSContext* cx, JS::OffThreadToken* token) {
   // The token is really a ParseTask* which should be in the finished list.
@@ -2056,6 +2181,7 @@ bool GlobalHelperThreadState::submitTask(PromiseHelperTask* task) {
   if (!promiseHelperTasks(lock).append(task)) {
     return false;
   }
+  task->noteQueued();
 
   dispatch(DispatchReason::NewTask, lock);
   return true;
@@ -2110,6 +2236,7 @@ void GlobalHelperThreadState::trace(JSTracer* trc) {
 // Priority is determined by the order they're listed here.
 const GlobalHelperThreadState::Selector GlobalHelperThreadState::selectors[] = {
     &GlobalHelperThreadState::maybeGetGCParallelTask,
+    &GlobalHelperThreadState::maybeGetParallelSortTask,
     &GlobalHelperThreadState::maybeGetIonCompileTask,
     &GlobalHelperThreadState::maybeGetWasmTier1CompileTask,
     &GlobalHelperThreadState::maybeGetPromiseHelperTask,
@@ -2124,8 +2251,8 @@ const GlobalHelperThreadState::Selector GlobalHelperThreadState::selectors[] = {
 
 bool GlobalHelperThreadState::canStartTasks(
     const AutoLockHelperThreadState& lock) {
-  return canStartGCParallelTask(lock) || canStartIonCompileTask(lock) ||
-         canStartWasmTier1CompileTask(lock) ||
+  return canStartGCParallelTask(lock) || canStartParallelSortTask(lock) ||
+         canStartIonCompileTask(lock) || canStartWasmTier1CompileTask(lock) ||
          canStartPromiseHelperTask(lock) || canStartParseTask(lock) ||
          canStartFreeDelazifyTask(lock) || canStartDelazifyTask(lock) ||
          canStartCompressionTask(lock) || canStartIonFreeTask(lock) ||
@@ -2186,6 +2313,23 @@ void GlobalHelperThreadState::runTaskLocked(HelperThreadTask* task,
   runningTaskCount[threadType]++;
   totalCountRunningTasks++;
 
+  if (!task->queuedTime().IsNull()) {
+    TimeStamp now = TimeStamp::Now();
+    TimeDuration waited = now - task->queuedTime();
+    TaskWaitStats& stats = taskWaitStats_[threadType];
+    stats.count++;
+    stats.total += waited;
+    if (waited > stats.max) {
+      stats.max = waited;
+    }
+
+    if (taskStartCallback) {
+      if (const char* name = HelperThreadTypeName(threadType)) {
+        taskStartCallback(name, task->queuedTime(), now);
+      }
+    }
+  }
+
   task->runHelperThreadTask(locked);
 
   // Delete task from helperTasks.
@@ -17,6 +17,7 @@
 #include "js/shadow/Zone.h"
 #include "js/Transcoding.h"
 #include "js/UniquePtr.h"
+#include "js/Utility.h"
 #include "threading/LockGuard.h"
 #include "threading/Mutex.h"
 #include "wasm/WasmConstants.h"
@@ -92,6 +93,10 @@ void DestroyHelperThreadsState();
 bool EnsureHelperThreadsInitialized();
 
 size_t GetHelperThreadCount();
+
+// Return a short name for the kind of helper thread task, or nullptr if
+// |threadType| isn't a kind of task.
+const char* HelperThreadTypeName(ThreadType threadType);
 size_t GetHelperThreadCPUCount();
 size_t GetMaxWasmCompilationThreads();
 
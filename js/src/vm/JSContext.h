@@ -137,6 +137,20 @@ enum class InterruptReason : uint32_t {
 
 enum class ShouldCaptureStack { Maybe, Always };
 
+// Counters for JSRope::flatten, exposed to tests through the ropeFlattenStats
+// testing function. They are only kept while enableRopeFlattenStats is on.
+struct RopeFlattenStats {
+  // Number of ropes flattened.
+  uint64_t count = 0;
+
+  // Number of those flattens that appended to the leftmost leaf's extensible
+  // buffer instead of allocating and filling a new one.
+  uint64_t reusedBufferCount = 0;
+
+  // Number of bytes of characters copied while flattening.
+  uint64_t bytesCopied = 0;
+};
+
 } /* namespace js */
 
 /*
@@ -499,6 +513,9 @@ struct JS_PUBLIC_API JSContext : public JS::RootingContext,
   // Match limit result for the most recent call to RegExpSearcher.
   js::ContextData<uint32_t> regExpSearcherLastLimit;
 
+  // Rope flattening counters, or Nothing if they aren't being collected.
+  js::ContextData<mozilla::Maybe<js::RopeFlattenStats>> ropeFlattenStats;
+
   static constexpr size_t offsetOfRegExpSearcherLastLimit() {
     return offsetof(JSContext, regExpSearcherLastLimit);
   }
@@ -15,7 +15,8 @@
 #include "mozilla/TextUtils.h"  // mozilla::AsciiAlphanumericToNumber, mozilla::IsAsciiDigit, mozilla::IsAsciiHexDigit
 
 #include <stddef.h>  // size_t
-#include <stdint.h>  // uint32_t
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string.h>  // memcpy
 #include <utility>   // std::move
 
 #include "jsnum.h"  // ParseDecimalNumber, GetFullInteger, FullStringToDouble
@@ -79,6 +80,50 @@ JSONToken JSONTokenizer<CharT, ParserT, StringBuilderT>::numberToken(double d) {
   return JSONToken::Number;
 }
 
+// Returns the number of characters at the start of |chars| that can appear
+// unescaped in a JSON string, i.e. everything except '"', '\\' and the control
+// characters U+0000 to U+001F.
+//
+// Long strings are common in large JSON payloads, so check a 64-bit word of
+// characters at a time, and only look at individual characters once a word
+// might contain one that ends the run.
+template <typename CharT>
+static size_t CountUnescapedStringChars(const CharT* chars, size_t length) {
+  static_assert(sizeof(CharT) == 1 || sizeof(CharT) == 2);
+
+  // |ones| has the lowest bit of each character set, and |highs| the highest.
+  constexpr size_t CharsPerWord = sizeof(uint64_t) / sizeof(CharT);
+  constexpr uint64_t ones =
+      sizeof(CharT) == 1 ? 0x0101010101010101 : 0x0001000100010001;
+  constexpr uint64_t highs = ones << (sizeof(CharT) * 8 - 1);
+
+  // Non-zero if any character in |word| is less than |n|, for |n| up to 0x80
+  // (or 0x8000 for char16_t). Borrows may also set the high bit of a later
+  // character, which is fine since we only care whether any bit is set.
+  auto hasLess = [](uint64_t word, uint64_t n) {
+    return (word - ones * n) & ~word & highs;
+  };
+
+  size_t i = 0;
+  for (; i + CharsPerWord <= length; i += CharsPerWord) {
+    uint64_t word;
+    memcpy(&word, chars + i, sizeof(word));
+    if (hasLess(word, 0x20) | hasLess(word ^ (ones * '"'), 1) |
+        hasLess(word ^ (ones * '\\'), 1)) {
+      break;
+    }
+  }
+
+  for (; i < length; i++) {
+    CharT c = chars[i];
+    if (c == '"' || c == '\\' || c <= 0x001F) {
+      break;
+    }
+  }
+
+  return i;
+}
+
 template <typename CharT, typename ParserT, typename StringBuilderT>
 template <JSONStringType ST>
 JSONToken JSONTokenizer<CharT, ParserT, StringBuilderT>::readString() {
@@ -100,18 +145,16 @@ JSONToken JSONTokenizer<CharT, ParserT, StringBuilderT>::readString() {
    * string directly from the source text.
    */
   CharPtr start = current;
-  for (; current < end; current++) {
+  current += CountUnescapedStringChars(current.get(), end - current);
+  if (current < end) {
     if (*current == '"') {
       size_t length = current - start;
       current++;
       return stringToken<ST>(start, length);
     }
 
-    if (*current == '\\') {
-      break;
-    }
-
-    if (*current <= 0x001F) {
+    if (*current != '\\') {
+      MOZ_ASSERT(*current <= 0x001F);
       error("bad control character in string literal");
       return token(JSONToken::Error);
     }
@@ -211,11 +254,7 @@ JSONToken JSONTokenizer<CharT, ParserT, StringBuilderT>::readString() {
     }
 
     start = current;
-    for (; current < end; current++) {
-      if (*current == '"' || *current == '\\' || *current <= 0x001F) {
-        break;
-      }
-    }
+    current += CountUnescapedStringChars(current.get(), end - current);
   } while (current < end);
 
   error("unterminated string");
@@ -0,0 +1,155 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef vm_ParallelSort_h
+#define vm_ParallelSort_h
+
+#include "mozilla/Maybe.h"
+
+#include <utility>
+
+#include "ds/Sort.h"
+#include "vm/HelperThreadState.h"
+#include "vm/JSContext.h"
+
+namespace js {
+
+// Arrays shorter than this are always sorted on the calling thread; below it
+// the cost of dispatching helper thread work outweighs the gain.
+static constexpr size_t ParallelSortMinLength = 256 * 1024;
+
+namespace detail {
+
+// The number of independently sorted chunks. It's fixed so that the result
+// doesn't depend on how many helper threads are available, and is a power of
+// four so that the merge passes leave the result in the original array.
+static constexpr size_t ParallelSortChunkCount = 4;
+
+// Runs a single sort or merge step of ParallelSort, either on a helper thread
+// or, if no helper thread picks it up in time, on the main thread when joined.
+template <typename Step>
+class ParallelSortStepTask final : public ParallelSortTask {
+  Step step_;
+
+  bool runStep() override { return step_(); }
+
+ public:
+  explicit ParallelSortStepTask(Step&& step) : step_(std::move(step)) {}
+  ~ParallelSortStepTask() override { join(); }
+};
+
+// Run |makeStep(i)| for every |i| in [0, count). Step zero runs on the calling
+// thread and the rest are offered to helper threads. Returns false if any step
+// failed.
+template <typename MakeStep>
+[[nodiscard]] bool RunParallelSortSteps(JSContext* cx, size_t count,
+                                        MakeStep makeStep) {
+  using Step = decltype(makeStep(size_t(0)));
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(cx->runtime()));
+  MOZ_ASSERT(count <= ParallelSortChunkCount);
+
+  mozilla::Maybe<ParallelSortStepTask<Step>> tasks[ParallelSortChunkCount];
+  for (size_t i = 1; i < count; i++) {
+    tasks[i].emplace(makeStep(i));
+    tasks[i]->start();
+  }
+
+  bool ok = makeStep(0)();
+
+  for (size_t i = 1; i < count; i++) {
+    tasks[i]->join();
+    ok = ok && tasks[i]->ok();
+  }
+
+  return ok;
+}
+
+}  // namespace detail
+
+/*
+ * Sort |array| like MergeSort, splitting the work across the JS helper
+ * threads when the array is large enough to make that worthwhile.
+ *
+ * The array is split into a fixed number of chunks that are sorted in parallel
+ * with |sortChunk|, and the sorted chunks are then merged pairwise, also in
+ * parallel. |sortChunk| is called as
+ *
+ *     bool sortChunk(T* chunk, size_t length, T* scratch);
+ *
+ * where |scratch| has room for |length| elements. Merges are stable and take
+ * from the left run on ties, so if |sortChunk| is stable the whole sort is too,
+ * and the result is identical to a sequential stable sort for any consistent
+ * comparator.
+ *
+ * Both |sortChunk| and |c| may run off the main thread, so they must not touch
+ * the JSContext or any GC things, and must not fail except for reasons that
+ * are already reported (they cannot report errors themselves).
+ */
+template <typename T, typename SortChunk, typename Comparator>
+[[nodiscard]] bool ParallelSort(JSContext* cx, T* array, size_t nelems,
+                                T* scratch, SortChunk sortChunk,
+                                Comparator c) {
+  using detail::ParallelSortChunkCount;
+
+  if (nelems < ParallelSortMinLength || !CanUseExtraThreads()) {
+    return sortChunk(array, nelems, scratch);
+  }
+
+  size_t bounds[ParallelSortChunkCount + 1];
+  for (size_t i = 0; i <= ParallelSortChunkCount; i++) {
+    bounds[i] = nelems * i / ParallelSortChunkCount;
+  }
+
+  if (!detail::RunParallelSortSteps(
+          cx, ParallelSortChunkCount, [=](size_t i) {
+            return [=]() {
+              return sortChunk(array + bounds[i], bounds[i + 1] - bounds[i],
+                               scratch + bounds[i]);
+            };
+          })) {
+    return false;
+  }
+
+  T* src = array;
+  T* dst = scratch;
+  for (size_t width = 1; width < ParallelSortChunkCount; width *= 2) {
+    size_t merges = ParallelSortChunkCount / (2 * width);
+    if (!detail::RunParallelSortSteps(cx, merges, [=](size_t i) {
+          return [=]() {
+            size_t lo = bounds[2 * width * i];
+            size_t mid = bounds[2 * width * i + width];
+            size_t hi = bounds[2 * width * (i + 1)];
+            return detail::MergeArrayRuns(dst + lo, src + lo, mid - lo,
+                                          hi - mid, c);
+          };
+        })) {
+      return false;
+    }
+    std::swap(src, dst);
+  }
+
+  MOZ_ASSERT(src == array);
+  return true;
+}
+
+/*
+ * Stable merge sort of |array| that uses helper threads for large inputs. See
+ * ParallelSort for the requirements on |c|.
+ */
+template <typename T, typename Comparator>
+[[nodiscard]] bool ParallelMergeSort(JSContext* cx, T* array, size_t nelems,
+                                     T* scratch, Comparator c) {
+  return ParallelSort(
+      cx, array, nelems, scratch,
+      [c](T* chunk, size_t length, T* chunkScratch) {
+        return MergeSort(chunk, length, chunkScratch, c);
+      },
+      c);
+}
+
+} /* namespace js */
+
+#endif /* vm_ParallelSort_h */
@@ -23,6 +23,7 @@
 #include "frontend/CompilationStencil.h"
 #include "frontend/ParserAtom.h"  // frontend::WellKnownParserAtoms
 #include "gc/GC.h"
+#include "gc/Memory.h"
 #include "gc/PublicIterators.h"
 #include "jit/IonCompileTask.h"
 #include "jit/JitRuntime.h"
@@ -352,6 +353,12 @@ void JSRuntime::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
     rtSizes->atomsTable +=
         js::frontend::WellKnownParserAtoms::getSingleton().sizeOfExcludingThis(
             mallocSizeOf);
+
+    // This covers all anonymous memory in the process, not just memory owned
+    // by JS, so only the main runtime reports it.
+    if (gc::HugePagesEnabled()) {
+      rtSizes->hugePages = gc::GetHugePageBytes();
+    }
   }
 
 #ifdef JS_HAS_INTL_API
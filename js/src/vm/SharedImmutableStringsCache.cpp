@@ -66,18 +66,29 @@ SharedImmutableString::~SharedImmutableString() {
     return;
   }
 
+  // If this isn't the last reference we can drop it without the lock. The
+  // last reference must be dropped under the lock, so that a concurrent lookup
+  // can't find the chars as they're being freed.
+  size_t count = box_->refcount;
+  while (count > 1) {
+    if (box_->refcount.compareExchange(count, count - 1)) {
+      return;
+    }
+    count = box_->refcount;
+  }
+
   auto locked = box_->cache_->lock();
 
   MOZ_ASSERT(box_->refcount > 0);
 
-  box_->refcount--;
-  if (box_->refcount == 0) {
+  if (--box_->refcount == 0) {
     box_->chars_.reset(nullptr);
   }
 }
 
 SharedImmutableString SharedImmutableString::clone() const {
-  auto locked = box_->cache_->lock();
+  // We already hold a reference, so the count can't drop to zero while we add
+  // another and no lock is needed.
   MOZ_ASSERT(box_);
   MOZ_ASSERT(box_->refcount > 0);
   return SharedImmutableString(box_);
@@ -101,24 +112,25 @@ SharedImmutableTwoByteString SharedImmutableTwoByteString::clone() const {
 }
 
 bool SharedImmutableStringsCache::init() {
-  MOZ_ASSERT(!inner_);
-
-  auto* inner =
-      js_new<ExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
-  if (!inner) {
-    return false;
+  MOZ_ASSERT(!initialized());
+
+  for (const ExclusiveData<Inner>*& shard : shards_) {
+    shard = js_new<ExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
+    if (!shard) {
+      free();
+      return false;
+    }
   }
 
-  auto locked = inner->lock();
-  inner_ = locked.parent();
-
   return true;
 }
 
 void SharedImmutableStringsCache::free() {
-  if (inner_) {
-    js_delete(inner_);
-    inner_ = nullptr;
+  for (const ExclusiveData<Inner>*& shard : shards_) {
+    if (shard) {
+      js_delete(shard);
+      shard = nullptr;
+    }
   }
 }
 
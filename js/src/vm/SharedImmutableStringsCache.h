@@ -7,6 +7,7 @@
 #ifndef vm_SharedImmutableStringsCache_h
 #define vm_SharedImmutableStringsCache_h
 
+#include "mozilla/Atomics.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/UniquePtr.h"
 
@@ -31,10 +32,16 @@ class SharedImmutableTwoByteString;
  * immutable strings (either `const char*` [any encoding, not restricted to
  * only Latin-1 or only UTF-8] or `const char16_t*`) between threads.
  *
- * The locking mechanism is dead-simple and coarse grained: a single lock guards
- * all of the internal table itself, the table's entries, and the entries'
- * reference counts. It is only safe to perform any mutation on the cache or any
- * data stored within the cache when this lock is acquired.
+ * The cache is split into a fixed number of shards, chosen by the string's
+ * hash, so that threads looking up different strings rarely contend. Each
+ * shard has its own lock, which guards the shard's table and its entries. It is
+ * only safe to mutate a shard's table, or to free an entry's chars, while that
+ * shard's lock is held.
+ *
+ * Reference counts are atomic. Taking another reference to a string that is
+ * already held (`clone`), and dropping a reference that isn't the last one, do
+ * not take any lock. Only a transition of the count from zero to one (a lookup)
+ * or from one to zero (freeing the chars) happens under the shard's lock.
  */
 class SharedImmutableStringsCache {
   static SharedImmutableStringsCache singleton_;
@@ -135,19 +142,23 @@ class SharedImmutableStringsCache {
                                                          size_t length);
 
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
-    MOZ_ASSERT(inner_);
-    size_t n = mallocSizeOf(inner_);
+    MOZ_ASSERT(initialized());
+    size_t n = 0;
+
+    for (const ExclusiveData<Inner>* shard : shards_) {
+      n += mallocSizeOf(shard);
 
-    auto locked = inner_->lock();
+      auto locked = shard->lock();
 
-    // Size of the table.
-    n += locked->set.shallowSizeOfExcludingThis(mallocSizeOf);
+      // Size of the table.
+      n += locked->set.shallowSizeOfExcludingThis(mallocSizeOf);
 
-    // Sizes of the strings and their boxes.
-    for (auto r = locked->set.all(); !r.empty(); r.popFront()) {
-      n += mallocSizeOf(r.front().get());
-      if (const char* chars = r.front()->chars()) {
-        n += mallocSizeOf(chars);
+      // Sizes of the strings and their boxes.
+      for (auto r = locked->set.all(); !r.empty(); r.popFront()) {
+        n += mallocSizeOf(r.front().get());
+        if (const char* chars = r.front()->chars()) {
+          n += mallocSizeOf(chars);
+        }
       }
     }
 
@@ -163,7 +174,7 @@ class SharedImmutableStringsCache {
   static void freeSingleton();
 
   static SharedImmutableStringsCache& getSingleton() {
-    MOZ_ASSERT(singleton_.inner_);
+    MOZ_ASSERT(singleton_.initialized());
     return singleton_;
   }
 
@@ -185,16 +196,18 @@ class SharedImmutableStringsCache {
    * Purge the cache of all refcount == 0 entries.
    */
   void purge() {
-    auto locked = inner_->lock();
-
-    for (Inner::Set::Enum e(locked->set); !e.empty(); e.popFront()) {
-      if (e.front()->refcount == 0) {
-        // The chars should be eagerly freed when refcount reaches zero.
-        MOZ_ASSERT(!e.front()->chars());
-        e.removeFront();
-      } else {
-        // The chars should exist as long as the refcount is non-zero.
-        MOZ_ASSERT(e.front()->chars());
+    for (const ExclusiveData<Inner>* shard : shards_) {
+      auto locked = shard->lock();
+
+      for (Inner::Set::Enum e(locked->set); !e.empty(); e.popFront()) {
+        if (e.front()->refcount == 0) {
+          // The chars should be eagerly freed when refcount reaches zero.
+          MOZ_ASSERT(!e.front()->chars());
+          e.removeFront();
+        } else {
+          // The chars should exist as long as the refcount is non-zero.
+          MOZ_ASSERT(e.front()->chars());
+        }
       }
     }
   }
@@ -209,7 +222,7 @@ class SharedImmutableStringsCache {
     const ExclusiveData<Inner>* cache_;
 
    public:
-    mutable size_t refcount;
+    mutable mozilla::Atomic<size_t, mozilla::ReleaseAcquire> refcount;
 
     using Ptr = js::UniquePtr<StringBox>;
 
@@ -314,7 +327,17 @@ class SharedImmutableStringsCache {
     Inner& operator=(const Inner&) = delete;
   };
 
-  const ExclusiveData<Inner>* inner_ = nullptr;
+  // The number of shards. This must be a power of two.
+  static constexpr size_t NumShards = 16;
+
+  const ExclusiveData<Inner>* shards_[NumShards] = {};
+
+  bool initialized() const { return shards_[0]; }
+
+  const ExclusiveData<Inner>* shardFor(HashNumber hash) const {
+    MOZ_ASSERT(initialized());
+    return shards_[hash & (NumShards - 1)];
+  }
 };
 
 /**
@@ -650,7 +650,13 @@ JSLinearString* JSRope::flatten(JSContext* maybecx) {
     entry.emplace(maybecx, "JSRope::flatten");
   }
 
-  JSLinearString* str = flattenInternal();
+  // Flatten statistics are only collected when a test has asked for them.
+  RopeFlattenStats* stats = nullptr;
+  if (maybecx && maybecx->ropeFlattenStats.ref()) {
+    stats = maybecx->ropeFlattenStats.ref().ptr();
+  }
+
+  JSLinearString* str = flattenInternal(stats);
   if (!str && maybecx) {
     ReportOutOfMemory(maybecx);
   }
@@ -658,26 +664,27 @@ JSLinearString* JSRope::flatten(JSContext* maybecx) {
   return str;
 }
 
-JSLinearString* JSRope::flattenInternal() {
+JSLinearString* JSRope::flattenInternal(RopeFlattenStats* stats) {
   if (zone()->needsIncrementalBarrier()) {
-    return flattenInternal<WithIncrementalBarrier>();
+    return flattenInternal<WithIncrementalBarrier>(stats);
   }
 
-  return flattenInternal<NoBarrier>();
+  return flattenInternal<NoBarrier>(stats);
 }
 
 template <JSRope::UsingBarrier usingBarrier>
-JSLinearString* JSRope::flattenInternal() {
+JSLinearString* JSRope::flattenInternal(RopeFlattenStats* stats) {
   if (hasTwoByteChars()) {
-    return flattenInternal<usingBarrier, char16_t>(this);
+    return flattenInternal<usingBarrier, char16_t>(this, stats);
   }
 
-  return flattenInternal<usingBarrier, Latin1Char>(this);
+  return flattenInternal<usingBarrier, Latin1Char>(this, stats);
 }
 
 template <JSRope::UsingBarrier usingBarrier, typename CharT>
 /* static */
-JSLinearString* JSRope::flattenInternal(JSRope* root) {
+JSLinearString* JSRope::flattenInternal(JSRope* root,
+                                        RopeFlattenStats* stats) {
   /*
    * Consider the DAG of JSRopes rooted at |root|, with non-JSRopes as
    * its leaves. Mutate the root JSRope into a JSExtensibleString containing
@@ -889,6 +896,16 @@ finish_root:
     }
   }
 
+  if (stats) {
+    size_t copiedLength = wholeLength;
+    if (reuseLeftmostBuffer) {
+      copiedLength -= leftmostChild->length();
+    }
+    stats->count++;
+    stats->reusedBufferCount += reuseLeftmostBuffer;
+    stats->bytesCopied += copiedLength * sizeof(CharT);
+  }
+
   return &root->asLinear();
 }
 
@@ -44,6 +44,7 @@ namespace js {
 class ArrayObject;
 class GenericPrinter;
 class PropertyName;
+struct RopeFlattenStats;
 class StringBuffer;
 
 namespace frontend {
@@ -720,12 +721,13 @@ class JSRope : public JSString {
   friend class JSString;
   JSLinearString* flatten(JSContext* maybecx);
 
-  JSLinearString* flattenInternal();
+  JSLinearString* flattenInternal(js::RopeFlattenStats* stats);
   template <UsingBarrier usingBarrier>
-  JSLinearString* flattenInternal();
+  JSLinearString* flattenInternal(js::RopeFlattenStats* stats);
 
   template <UsingBarrier usingBarrier, typename CharT>
-  static JSLinearString* flattenInternal(JSRope* root);
+  static JSLinearString* flattenInternal(JSRope* root,
+                                         js::RopeFlattenStats* stats);
 
   template <UsingBarrier usingBarrier>
   static void ropeBarrierDuringFlattening(JSRope* rope);
@@ -46,6 +46,7 @@
 #include "vm/GlobalObject.h"
 #include "vm/JSContext.h"
 #include "vm/JSObject.h"
+#include "vm/ParallelSort.h"
 #include "vm/PIC.h"
 #include "vm/SelfHosting.h"
 #include "vm/SharedMem.h"
@@ -2683,10 +2684,85 @@ static void SortByColumn(SharedMem<U*> data, size_t length, SharedMem<U*> aux,
   Ops::podCopy(data, aux, length);
 }
 
+// Sort a large typed array by sorting equal chunks of it on helper threads and
+// then merging the sorted chunks. Like radix sort this uses O(n) additional
+// space, so callers are expected to apply the same limit on |length|.
+template <typename T, typename Ops>
+static bool TypedArrayParallelSort(JSContext* cx,
+                                   TypedArrayObject* typedArray) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+                "Parallel sort is only used for 32- and 64-bit elements");
+  static_assert(std::is_same_v<Ops, UnsharedOps>,
+                "Parallel sort only works on unshared data");
+
+  using UnsignedT =
+      typename mozilla::UnsignedStdintTypeForSize<sizeof(T)>::Type;
+
+  size_t length = typedArray->length();
+
+  auto ptr = cx->make_pod_array<UnsignedT>(length);
+  if (!ptr) {
+    return false;
+  }
+
+  UnsignedT* data =
+      typedArray->dataPointerEither().cast<UnsignedT*>().unwrapUnshared();
+
+  auto sortChunk = [](UnsignedT* chunk, size_t chunkLength,
+                      UnsignedT* chunkScratch) {
+    if constexpr (sizeof(T) == 4) {
+      auto chunkData = SharedMem<UnsignedT*>::unshared(chunk);
+      auto aux = SharedMem<UnsignedT*>::unshared(chunkScratch);
+      for (uint8_t col = 0; col < sizeof(UnsignedT); col++) {
+        SortByColumn<T, UnsignedT, UnsharedOps>(chunkData, chunkLength, aux,
+                                                col);
+      }
+    } else {
+      TypedArrayStdSort<T>(SharedMem<void*>::unshared(chunk), chunkLength);
+    }
+    return true;
+  };
+
+  auto comparator = [](UnsignedT x, UnsignedT y, bool* lessOrEqualp) {
+    constexpr auto SortValue = UnsignedSortValue<T, UnsignedT>;
+    *lessOrEqualp = SortValue(x) <= SortValue(y);
+    return true;
+  };
+
+  MOZ_ALWAYS_TRUE(
+      ParallelSort(cx, data, length, ptr.get(), sortChunk, comparator));
+  return true;
+}
+
+template <typename T>
+static constexpr bool UseTypedArrayParallelSort(size_t length) {
+  // Parallel sort uses O(n) additional space, limit this space to 64 MB.
+  return length >= ParallelSortMinLength &&
+         length < (64 * 1024 * 1024) / sizeof(T);
+}
+
+template <typename T, typename Ops>
+static bool TypedArrayStdOrParallelSort(JSContext* cx,
+                                        TypedArrayObject* typedArray) {
+  if constexpr (std::is_same_v<Ops, UnsharedOps>) {
+    if (UseTypedArrayParallelSort<T>(typedArray->length())) {
+      return TypedArrayParallelSort<T, Ops>(cx, typedArray);
+    }
+  }
+  return TypedArrayStdSort<T, Ops>(cx, typedArray);
+}
+
 template <typename T, typename Ops>
 static bool TypedArrayRadixSort(JSContext* cx, TypedArrayObject* typedArray) {
   size_t length = typedArray->length();
 
+  // Large unshared arrays are radix sorted in chunks on helper threads.
+  if constexpr (sizeof(T) == 4 && std::is_same_v<Ops, UnsharedOps>) {
+    if (UseTypedArrayParallelSort<T>(length)) {
+      return TypedArrayParallelSort<T, Ops>(cx, typedArray);
+    }
+  }
+
   // Determined by performance testing.
   constexpr size_t StdSortMinCutoff = sizeof(T) == 2 ? 64 : 256;
 
@@ -2766,7 +2842,7 @@ TypedArraySort() {
 template <typename T, typename Ops>
 static constexpr typename std::enable_if_t<sizeof(T) == 8, TypedArraySortFn>
 TypedArraySort() {
-  return TypedArrayStdSort<T, Ops>;
+  return TypedArrayStdOrParallelSort<T, Ops>;
 }
 
 bool js::intrinsic_TypedArrayNativeSort(JSContext* cx, unsigned argc,
@@ -770,19 +770,35 @@ bool wasm::CompileTier2(const CompileArgs& args, const Bytes& bytecode,
 
 class StreamingDecoder {
   Decoder d_;
+  ModuleGenerator& mg_;
   const ExclusiveBytesPtr& codeBytesEnd_;
   const Atomic<bool>& cancelled_;
+  bool flushFailed_;
+
+  bool bytesArrived(const uint8_t* requiredEnd) const {
+    auto codeBytesEnd = codeBytesEnd_.lock();
+    return codeBytesEnd >= requiredEnd;
+  }
 
  public:
   StreamingDecoder(const ModuleEnvironment& env, const Bytes& begin,
-                   const ExclusiveBytesPtr& codeBytesEnd,
+                   ModuleGenerator& mg, const ExclusiveBytesPtr& codeBytesEnd,
                    const Atomic<bool>& cancelled, UniqueChars* error,
                    UniqueCharsVector* warnings)
       : d_(begin, env.codeSection->start, error, warnings),
+        mg_(mg),
         codeBytesEnd_(codeBytesEnd),
-        cancelled_(cancelled) {}
+        cancelled_(cancelled),
+        flushFailed_(false) {}
 
-  bool fail(const char* msg) { return d_.fail(msg); }
+  bool fail(const char* msg) {
+    // A failed flush has already reported the compilation error; don't
+    // replace it with a decoding error.
+    if (flushFailed_) {
+      return false;
+    }
+    return d_.fail(msg);
+  }
 
   bool done() const { return d_.done(); }
 
@@ -791,6 +807,15 @@ class StreamingDecoder {
   bool waitForBytes(size_t numBytes) {
     numBytes = std::min(numBytes, d_.bytesRemain());
     const uint8_t* requiredEnd = d_.currentPosition() + numBytes;
+
+    // If we're about to block on the network, first hand the function bodies
+    // decoded so far to the compiler instead of leaving them in a partially
+    // filled batch, so that validation and compilation overlap the download.
+    if (!bytesArrived(requiredEnd) && !mg_.flushFuncDefs()) {
+      flushFailed_ = true;
+      return false;
+    }
+
     auto codeBytesEnd = codeBytesEnd_.lock();
     while (codeBytesEnd < requiredEnd) {
       if (cancelled_) {
@@ -879,8 +904,8 @@ SharedModule wasm::CompileStreaming(
   }
 
   {
-    StreamingDecoder d(moduleEnv, codeBytes, codeBytesEnd, cancelled, error,
-                       warnings);
+    StreamingDecoder d(moduleEnv, codeBytes, mg, codeBytesEnd, cancelled,
+                       error, warnings);
 
     if (!DecodeCodeSection(moduleEnv, d, mg)) {
       return nullptr;
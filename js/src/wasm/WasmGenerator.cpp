@@ -895,6 +895,16 @@ bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
   return true;
 }
 
+bool ModuleGenerator::flushFuncDefs() {
+  MOZ_ASSERT(!finishedFuncDefs_);
+
+  if (!currentTask_ || currentTask_->inputs.empty()) {
+    return true;
+  }
+
+  return launchBatchCompile();
+}
+
 bool ModuleGenerator::finishFuncDefs() {
   MOZ_ASSERT(!finishedFuncDefs_);
 
@@ -248,6 +248,11 @@ class MOZ_STACK_CLASS ModuleGenerator {
 
   [[nodiscard]] bool finishFuncDefs();
 
+  // Start compiling any function definitions that have been added with
+  // compileFuncDef() but are still waiting for their batch to fill up. Used
+  // when streaming, so that compilation keeps pace with the arrival of bytes.
+  [[nodiscard]] bool flushFuncDefs();
+
   // If env->mode is Once or Tier1, finishModule() must be called to generate
   // a new Module. Otherwise, if env->mode is Tier2, finishTier2() must be
   // called to augment the given Module with tier 2 code.
@@ -1294,8 +1294,16 @@ already_AddRefed<JS::Stencil> ScriptPreloader::CachedStencil::GetStencil(
   auto start = TimeStamp::Now();
   LOG(Info, "Decoding stencil %s on main thread...\n", mURL.get());
 
+  JS::DecodeOptions decodeOptions(options);
+  if (IsMemMapped()) {
+    // Like the off-thread decode, the mmapped cache outlives the JS runtime,
+    // so the bytecode can be used in place instead of being copied out.
+    MOZ_ASSERT(decodeOptions.borrowBuffer);
+    decodeOptions.usePinnedBytecode = true;
+  }
+
   RefPtr<JS::Stencil> stencil;
-  if (JS::DecodeStencil(cx, options, Range(), getter_AddRefs(stencil)) ==
+  if (JS::DecodeStencil(cx, decodeOptions, Range(), getter_AddRefs(stencil)) ==
       JS::TranscodeResult::Ok) {
     // Lock the monitor here to avoid data races on mScript
     // from other threads like the cache writing thread.
@@ -1190,6 +1190,15 @@ static void DispatchOffThreadTask(JS::DispatchReason) {
   TaskController::Get()->AddTask(MakeAndAddRef<HelperThreadTaskHandler>());
 }
 
+// Record how long each JS helper thread task waited in its queue, so that
+// profiles show when helper threads are the bottleneck.
+static void RecordHelperThreadTaskWait(const char* aTaskName,
+                                       TimeStamp aQueued, TimeStamp aStarted) {
+  PROFILER_MARKER_TEXT("JS helper thread task wait", JS,
+                       MarkerTiming::Interval(aQueued, aStarted),
+                       ProfilerString8View::WrapNullTerminatedString(aTaskName));
+}
+
 static bool CreateSelfHostedSharedMemory(JSContext* aCx,
                                          JS::SelfHostedCache aBuf) {
   auto& shm = xpc::SelfHostedShmem::GetSingleton();
@@ -1206,6 +1215,7 @@ nsresult XPCJSContext::Initialize() {
     size_t stackSize = TaskController::GetThreadStackSize();
     SetHelperThreadTaskCallback(&DispatchOffThreadTask, threadCount, stackSize);
   }
+  SetHelperThreadTaskStartCallback(&RecordHelperThreadTaskWait);
 
   nsresult rv =
       CycleCollectedJSContext::Initialize(nullptr, JS::DefaultHeapMaxBytes);
@@ -2338,6 +2338,15 @@ void JSReporter::CollectReports(WindowPaths* windowPaths,
         " to RSS, only vsize.");
   }
 
+  // Huge pages are only requested in the opt-in JS_GC_HUGE_PAGES mode.
+  if (rtStats.runtime.hugePages > 0) {
+    REPORT_BYTES("huge-pages"_ns, KIND_OTHER, rtStats.runtime.hugePages,
+                 "Anonymous memory in the whole process that the OS backs "
+                 "with huge pages. This includes malloc heap and other "
+                 "memory that doesn't belong to JS, as well as GC chunks and "
+                 "wasm memories.");
+  }
+
   // Report the numbers for memory outside of realms.
 
   REPORT_BYTES("js-main-runtime/gc-heap/unused-chunks"_ns, KIND_OTHER,
@@ -28,6 +28,7 @@
 #  include <windows.h>
 #endif
 
+#include <algorithm>
 // For placement new used for arena allocations of zip file list
 #include <new>
 #define ZIP_ARENABLOCKSIZE (1 * 1024)
@@ -395,8 +396,8 @@ nsresult nsZipArchive::Test(const char* aEntryName) {
   }
 
   // test all items in archive
-  for (auto* item : mFiles) {
-    for (currItem = item; currItem; currItem = currItem->next) {
+  for (uint32_t slot = 0; slot < mFilesSize; slot++) {
+    for (currItem = mFiles[slot]; currItem; currItem = currItem->next) {
       //-- don't test (synthetic) directory items
       if (currItem->IsDirectory()) continue;
       nsresult rv = ExtractFile(currItem, 0, 0);
@@ -424,9 +425,10 @@ nsZipItem* nsZipArchive::GetItem(const char* aEntryName) {
       }
     }
     MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
-    nsZipItem* item = mFiles[HashName(aEntryName, len)];
+    uint32_t hash = HashName(aEntryName, len);
+    nsZipItem* item = mFiles[hash % mFilesSize];
     while (item) {
-      if ((len == item->nameLength) &&
+      if ((hash == item->nameHash) && (len == item->nameLength) &&
           (!memcmp(aEntryName, item->Name(), len))) {
         // Successful GetItem() is a good indicator that the file is about to be
         // read
@@ -556,7 +558,7 @@ nsresult nsZipFind::FindNext(const char** aResult, uint16_t* aNameLen) {
   *aNameLen = 0;
   MMAP_FAULT_HANDLER_BEGIN_HANDLE(mArchive->GetFD())
   // we start from last match, look for next
-  while (mSlot < ZIP_TABSIZE) {
+  while (mSlot < mArchive->mFilesSize) {
     // move to next in current chain, or move to new slot
     mItem = mItem ? mItem->next : mArchive->mFiles[mSlot];
 
@@ -644,7 +646,13 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
     return NS_ERROR_FILE_CORRUPTED;
   }
 
-  //-- Read the central directory headers
+  //-- Read the central directory headers into a list, and only distribute
+  //-- them into the file table once we know how large it should be. The list
+  //-- is kept in central directory order so that the table's chains come out
+  //-- in the same order as if each item had been added as it was read.
+  nsZipItem* items = nullptr;
+  nsZipItem** itemsTail = &items;
+  uint32_t itemCount = 0;
   uint32_t sig = 0;
   while ((buf + int32_t(sizeof(uint32_t)) > buf) &&
          (buf + int32_t(sizeof(uint32_t)) <= endp) &&
@@ -687,9 +695,11 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
     nsDependentCSubstring name(item->Name(), namelen);
     LOG(("   %s", PromiseFlatCString(name).get()));
 #endif
-    uint32_t hash = HashName(item->Name(), namelen);
-    item->next = mFiles[hash];
-    mFiles[hash] = item;
+    item->nameHash = HashName(item->Name(), namelen);
+    item->next = nullptr;
+    *itemsTail = item;
+    itemsTail = &item->next;
+    itemCount++;
 
     sig = 0;
   } /* while reading central directory records */
@@ -698,6 +708,24 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
     return NS_ERROR_FILE_CORRUPTED;
   }
 
+  // Aim for an average chain length of about one.
+  mFilesSize = std::max<uint32_t>(ZIP_TABSIZE, itemCount);
+  mFiles = (nsZipItem**)mArena.Allocate(mFilesSize * sizeof(nsZipItem*),
+                                        mozilla::fallible);
+  if (!mFiles) {
+    mFilesSize = 0;
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+  memset(mFiles, 0, mFilesSize * sizeof(nsZipItem*));
+
+  while (items) {
+    nsZipItem* item = items;
+    items = item->next;
+    uint32_t slot = item->nameHash % mFilesSize;
+    item->next = mFiles[slot];
+    mFiles[slot] = item;
+  }
+
   MMAP_FAULT_HANDLER_CATCH(NS_ERROR_FAILURE)
   return NS_OK;
 }
@@ -714,8 +742,8 @@ nsresult nsZipArchive::BuildSynthetics() {
   MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
   // Create synthetic entries for any missing directories.
   // Do this when all ziptable has scanned to prevent double entries.
-  for (auto* item : mFiles) {
-    for (; item != nullptr; item = item->next) {
+  for (uint32_t slot = 0; slot < mFilesSize; slot++) {
+    for (nsZipItem* item = mFiles[slot]; item != nullptr; item = item->next) {
       if (item->isSynthetic) continue;
 
       //-- add entries for directories in the current item's path
@@ -737,9 +765,10 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Is the directory already in the file table?
         uint32_t hash = HashName(item->Name(), dirlen);
+        uint32_t dirSlot = hash % mFilesSize;
         bool found = false;
-        for (nsZipItem* zi = mFiles[hash]; zi != nullptr; zi = zi->next) {
-          if ((dirlen == zi->nameLength) &&
+        for (nsZipItem* zi = mFiles[dirSlot]; zi != nullptr; zi = zi->next) {
+          if ((hash == zi->nameHash) && (dirlen == zi->nameLength) &&
               (0 == memcmp(item->Name(), zi->Name(), dirlen))) {
             // we've already added this dir and all its parents
             found = true;
@@ -756,12 +785,13 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Point to the central record of the original item for the name part.
         diritem->central = item->central;
+        diritem->nameHash = hash;
         diritem->nameLength = dirlen;
         diritem->isSynthetic = true;
 
         // add diritem to the file table
-        diritem->next = mFiles[hash];
-        mFiles[hash] = diritem;
+        diritem->next = mFiles[dirSlot];
+        mFiles[dirSlot] = diritem;
       } /* end processing of dirs in item's name */
     }
   }
@@ -853,9 +883,12 @@ int64_t nsZipArchive::SizeOfMapping() { return mFd ? mFd->SizeOfMapping() : 0; }
 
 nsZipArchive::nsZipArchive(nsZipHandle* aZipHandle, PRFileDesc* aFd,
                            nsresult& aRv)
-    : mRefCnt(0), mFd(aZipHandle), mUseZipLog(false), mBuiltSynthetics(false) {
-  // initialize the table to nullptr
-  memset(mFiles, 0, sizeof(mFiles));
+    : mRefCnt(0),
+      mFd(aZipHandle),
+      mUseZipLog(false),
+      mFiles(nullptr),
+      mFilesSize(0),
+      mBuiltSynthetics(false) {
   MOZ_DIAGNOSTIC_ASSERT(aZipHandle);
 
   //-- get table of contents for archive
@@ -949,7 +982,8 @@ nsZipFind::~nsZipFind() {
 /*
  * HashName
  *
- * returns a hash key for the entry name
+ * returns a hash key for the entry name, to be reduced modulo the size of
+ * the file table
  */
 MOZ_NO_SANITIZE_UNSIGNED_OVERFLOW
 static uint32_t HashName(const char* aName, uint16_t len) {
@@ -962,7 +996,7 @@ static uint32_t HashName(const char* aName, uint16_t len) {
     val = val * 37 + *p++;
   }
 
-  return (val % ZIP_TABSIZE);
+  return val;
 }
 
 /*
@@ -1018,7 +1052,11 @@ static PRTime GetModTime(uint16_t aDate, uint16_t aTime) {
 }
 
 nsZipItem::nsZipItem()
-    : next(nullptr), central(nullptr), nameLength(0), isSynthetic(false) {}
+    : next(nullptr),
+      central(nullptr),
+      nameHash(0),
+      nameLength(0),
+      isSynthetic(false) {}
 
 uint32_t nsZipItem::LocalOffset() { return xtolong(central->localhdr_offset); }
 
@@ -8,7 +8,7 @@
 
 #include "mozilla/Attributes.h"
 
-#define ZIP_TABSIZE 256
+#define ZIP_TABSIZE 256 /* Minimum number of buckets in the file table */
 #define ZIP_BUFLEN \
   (4 * 1024) /* Used as output buffer when deflating items to a file */
 
@@ -68,6 +68,9 @@ class nsZipItem final {
 
   nsZipItem* next;
   const ZipCentral* central;
+  // Full hash of the name, so that lookups can skip non-matching items in a
+  // bucket without touching their central directory records.
+  uint32_t nameHash;
   uint16_t nameLength;
   bool isSynthetic;
 };
@@ -201,7 +204,10 @@ class nsZipArchive final {
 
   mozilla::Mutex mLock{"nsZipArchive"};
   // all of the following members are guarded by mLock:
-  nsZipItem* mFiles[ZIP_TABSIZE] MOZ_GUARDED_BY(mLock);
+  // The file table, sized by BuildFileList from the number of entries in the
+  // central directory so that chains stay short for large archives.
+  nsZipItem** mFiles MOZ_GUARDED_BY(mLock);
+  uint32_t mFilesSize MOZ_GUARDED_BY(mLock);
   mozilla::ArenaAllocator<1024, sizeof(void*)> mArena MOZ_GUARDED_BY(mLock);
   // Whether we synthesized the directory entries
   bool mBuiltSynthetics MOZ_GUARDED_BY(mLock);
@@ -232,7 +238,7 @@ class nsZipFind final {
   RefPtr<nsZipArchive> mArchive;
   char* mPattern;
   nsZipItem* mItem;
-  uint16_t mSlot;
+  uint32_t mSlot;
   bool mRegExp;
 
   nsZipFind& operator=(const nsZipFind& rhs) = delete;
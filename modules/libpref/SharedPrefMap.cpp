@@ -9,6 +9,7 @@
 #include "mozilla/dom/ipc/MemMapSnapshot.h"
 
 #include "mozilla/BinarySearch.h"
+#include "mozilla/PerfectHash.h"
 #include "mozilla/ResultExtensions.h"
 #include "mozilla/ipc/FileDescriptor.h"
 
@@ -60,6 +61,36 @@ Maybe<const SharedPrefMap::Pref> SharedPrefMap::Get(const char* aKey) const {
 }
 
 bool SharedPrefMap::Find(const char* aKey, size_t* aIndex) const {
+  if (KeyHashBaseCount()) {
+    return FindByHash(aKey, aIndex);
+  }
+  return FindBySearch(aKey, aIndex);
+}
+
+bool SharedPrefMap::FindByHash(const char* aKey, size_t* aIndex) const {
+  MOZ_ASSERT(KeyHashBaseCount());
+
+  size_t length = strlen(aKey);
+  uint32_t basis = KeyHashBases()[perfecthash::Hash(
+                                      perfecthash::FNV_OFFSET_BASIS, aKey,
+                                      length) %
+                                  KeyHashBaseCount()];
+  uint32_t index =
+      KeyHashSlots()[perfecthash::Hash(basis, aKey, length) % EntryCount()];
+
+  // Keys which are not in the map still hash to some entry, so we need to
+  // check that it actually matches.
+  const Entry& entry = Entries()[index];
+  if (entry.mKey.mLength != length ||
+      memcmp(aKey, KeyTable().GetBare(entry.mKey), length) != 0) {
+    return false;
+  }
+
+  *aIndex = index;
+  return true;
+}
+
+bool SharedPrefMap::FindBySearch(const char* aKey, size_t* aIndex) const {
   const auto& keys = KeyTable();
 
   return BinarySearchIf(
@@ -135,6 +166,90 @@ void SharedPrefMapBuilder::Add(const nsCString& aKey, const Flags& aFlags,
   });
 }
 
+/* static */
+bool SharedPrefMapBuilder::BuildKeyHash(const nsTArray<Entry*>& aEntries,
+                                        nsTArray<uint32_t>& aBases,
+                                        nsTArray<uint32_t>& aSlots) {
+  // The number of bases to try for a single bucket before giving up. In
+  // practice, even the last buckets placed, which have the fewest free slots to
+  // choose from, need far fewer attempts than this.
+  static constexpr uint32_t kMaxBasis = 1 << 16;
+
+  uint32_t count = aEntries.Length();
+  if (!count) {
+    return false;
+  }
+
+  auto hashKey = [&](uint32_t aBasis, uint32_t aIndex) {
+    const Entry* entry = aEntries[aIndex];
+    return perfecthash::Hash(aBasis, entry->mKeyString, entry->mKey.mLength);
+  };
+
+  // Group the keys into buckets by their initial hash. Each bucket gets its
+  // own basis, chosen so that all of its keys land in distinct, unused slots.
+  nsTArray<nsTArray<uint32_t>> buckets;
+  buckets.SetLength(count);
+  for (uint32_t i = 0; i < count; i++) {
+    buckets[hashKey(perfecthash::FNV_OFFSET_BASIS, i) % count].AppendElement(i);
+  }
+
+  // Place the largest buckets first, while there are still plenty of free
+  // slots for them.
+  nsTArray<uint32_t> order(count);
+  for (uint32_t i = 0; i < count; i++) {
+    order.AppendElement(i);
+  }
+  order.Sort([&](uint32_t aA, uint32_t aB) {
+    return int(buckets[aB].Length()) - int(buckets[aA].Length());
+  });
+
+  aBases.SetLength(count);
+  aSlots.SetLength(count);
+  nsTArray<bool> used;
+  used.SetLength(count);
+  for (auto& slot : used) {
+    slot = false;
+  }
+
+  AutoTArray<uint32_t, 8> slots;
+  for (uint32_t bucketIndex : order) {
+    const auto& bucket = buckets[bucketIndex];
+    if (bucket.IsEmpty()) {
+      aBases[bucketIndex] = 0;
+      continue;
+    }
+
+    uint32_t basis = 1;
+    for (;; basis++) {
+      if (basis > kMaxBasis) {
+        aBases.Clear();
+        aSlots.Clear();
+        return false;
+      }
+
+      slots.ClearAndRetainStorage();
+      for (uint32_t index : bucket) {
+        uint32_t slot = hashKey(basis, index) % count;
+        if (used[slot] || slots.Contains(slot)) {
+          break;
+        }
+        slots.AppendElement(slot);
+      }
+      if (slots.Length() == bucket.Length()) {
+        break;
+      }
+    }
+
+    aBases[bucketIndex] = basis;
+    for (size_t i = 0; i < slots.Length(); i++) {
+      used[slots[i]] = true;
+      aSlots[slots[i]] = bucket[i];
+    }
+  }
+
+  return true;
+}
+
 Result<Ok, nsresult> SharedPrefMapBuilder::Finalize(loader::AutoMemMap& aMap) {
   using Header = SharedPrefMap::Header;
 
@@ -149,6 +264,12 @@ Result<Ok, nsresult> SharedPrefMapBuilder::Finalize(loader::AutoMemMap& aMap) {
     return strcmp(aA->mKeyString, aB->mKeyString);
   });
 
+  nsTArray<uint32_t> keyHashBases;
+  nsTArray<uint32_t> keyHashSlots;
+  if (!BuildKeyHash(entries, keyHashBases, keyHashSlots)) {
+    NS_WARNING("Failed to build perfect hash for preference names");
+  }
+
   Header header = {uint32_t(entries.Length())};
 
   size_t offset = sizeof(header);
@@ -184,6 +305,15 @@ Result<Ok, nsresult> SharedPrefMapBuilder::Finalize(loader::AutoMemMap& aMap) {
   header.mValueStrings.mSize = mValueStringTable.Size();
   offset += header.mValueStrings.mSize;
 
+  offset += GetAlignmentOffset(offset, alignof(uint32_t));
+  header.mKeyHashBases.mOffset = offset;
+  header.mKeyHashBases.mSize = keyHashBases.Length() * sizeof(uint32_t);
+  offset += header.mKeyHashBases.mSize;
+
+  header.mKeyHashSlots.mOffset = offset;
+  header.mKeyHashSlots.mSize = keyHashSlots.Length() * sizeof(uint32_t);
+  offset += header.mKeyHashSlots.mSize;
+
   MemMapSnapshot mem;
   MOZ_TRY(mem.Init(offset));
 
@@ -224,6 +354,13 @@ Result<Ok, nsresult> SharedPrefMapBuilder::Finalize(loader::AutoMemMap& aMap) {
   mStringValueTable.WriteUserValues(
       {&ptr[header.mUserStringValues.mOffset], header.mUserStringValues.mSize});
 
+  if (!keyHashBases.IsEmpty()) {
+    memcpy(&ptr[header.mKeyHashBases.mOffset], keyHashBases.Elements(),
+           header.mKeyHashBases.mSize);
+    memcpy(&ptr[header.mKeyHashSlots.mOffset], keyHashSlots.Elements(),
+           header.mKeyHashSlots.mSize);
+  }
+
   mKeyTable.Clear();
   mValueStringTable.Clear();
   mIntValueTable.Clear();
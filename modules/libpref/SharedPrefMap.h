@@ -43,10 +43,12 @@ class SharedPrefMapBuilder;
 // whereas if we returned a nsDependentCString or a dynamically allocated
 // nsCString, it would.
 //
-// The set of entries is stored in sorted order by preference name, so look-ups
-// are done by binary search. This means that look-ups have O(log n) complexity,
-// rather than the O(1) complexity of a dynamic hashtable. Consumers should keep
-// this in mind when planning their accesses.
+// The set of entries is stored in sorted order by preference name, so that
+// they can be iterated in order. Look-ups go through a minimal perfect hash of
+// the preference names which is built along with the map, so they have O(1)
+// complexity and touch only a couple of cache lines. If the builder fails to
+// find a perfect hash, the map falls back to binary search over the sorted
+// entries, with O(log n) complexity.
 //
 // Important: The mapped memory created by this class is persistent. Once an
 // instance has been initialized, the memory that it allocates can never be
@@ -77,6 +79,8 @@ class SharedPrefMap {
   // - A set of data blocks, with offsets and sizes described by the DataBlock
   //   entries in the header, described below.
   //
+  // - The uint32_t arrays of the key hash table, described in the header.
+  //
   // Each entry stores its name string and values as indices into these blocks,
   // as documented in the Entry struct, but with some important optimizations:
   //
@@ -256,6 +260,14 @@ class SharedPrefMap {
     // The StringTable data block for string preference values, referenced by
     // the above two data blocks.
     DataBlock mValueStrings;
+
+    // The uint32_t arrays of the minimal perfect hash over preference names,
+    // in the same scheme as PerfectHash.h: a key's FNV hash selects a basis
+    // from mKeyHashBases, and its hash re-seeded with that basis selects a slot
+    // in mKeyHashSlots, which holds the index of its entry. Both blocks are
+    // empty if the builder failed to find a perfect hash.
+    DataBlock mKeyHashBases;
+    DataBlock mKeyHashSlots;
   };
 
   using StringTableEntry = mozilla::dom::ipc::StringTableEntry;
@@ -441,6 +453,11 @@ class SharedPrefMap {
   // places its index in the entry array in aIndex.
   bool Find(const char* aKey, size_t* aIndex) const;
 
+  // The two strategies used by Find(), depending on whether the map has a
+  // perfect hash. These are exposed separately for benchmarking.
+  bool FindByHash(const char* aKey, size_t* aIndex) const;
+  bool FindBySearch(const char* aKey, size_t* aIndex) const;
+
  public:
   // Returns the number of entries in the map.
   uint32_t Count() const { return EntryCount(); }
@@ -557,6 +574,17 @@ class SharedPrefMap {
     return {{&mMap.get<uint8_t>()[block.mOffset], block.mSize}};
   }
 
+  RangedPtr<const uint32_t> KeyHashBases() const {
+    return GetBlock<uint32_t>(GetHeader().mKeyHashBases);
+  }
+  uint32_t KeyHashBaseCount() const {
+    return GetHeader().mKeyHashBases.mSize / sizeof(uint32_t);
+  }
+
+  RangedPtr<const uint32_t> KeyHashSlots() const {
+    return GetBlock<uint32_t>(GetHeader().mKeyHashSlots);
+  }
+
   loader::AutoMemMap mMap;
 };
 
@@ -816,6 +844,15 @@ class MOZ_RAII SharedPrefMapBuilder {
     uint8_t mIsSkippedByIteration : 1;
   };
 
+  // Computes a minimal perfect hash for the given sorted entries, filling
+  // aBases with the intermediate basis table and aSlots with the index into
+  // aEntries of the entry assigned to each slot. Returns false, leaving both
+  // arrays empty, if no perfect hash was found within a bounded number of
+  // attempts.
+  static bool BuildKeyHash(const nsTArray<Entry*>& aEntries,
+                           nsTArray<uint32_t>& aBases,
+                           nsTArray<uint32_t>& aSlots);
+
   // Converts a builder Value struct to a SharedPrefMap::Value struct for
   // serialization. This must not be called before callers have finished adding
   // entries to the value array builders.
@@ -26,6 +26,7 @@
 #define kMinUnwrittenChanges 300
 #define kMinDumpInterval 20000  // in milliseconds
 #define kMaxBufSize 16384
+#define kMaxReadBufSize 262144
 #define kIndexVersion 0x0000000A
 #define kUpdateIndexStartDelay 50000  // in milliseconds
 #define kTelemetryReportBytesLimit (2U * 1024U * 1024U * 1024U)  // 2GB
@@ -2236,26 +2237,33 @@ void CacheIndex::ParseRecords(const StaticMutexAutoLock& aProofOfLock) {
 
   while (pos + sizeof(CacheIndexRecord) <= mRWBufPos &&
          mSkipEntries != entryCnt) {
-    CacheIndexRecord* rec = reinterpret_cast<CacheIndexRecord*>(mRWBuf + pos);
-    CacheIndexEntry tmpEntry(&rec->mHash);
-    tmpEntry.ReadFromBuf(mRWBuf + pos);
-
-    if (tmpEntry.IsDirty() || !tmpEntry.IsInitialized() ||
-        tmpEntry.IsFileEmpty() || tmpEntry.IsFresh() || tmpEntry.IsRemoved()) {
+    // Validate the record before creating an entry for it. Going through a
+    // temporary CacheIndexEntry would allocate a record wrapper and dispatch
+    // its deletion for every record in the index.
+    uint32_t flags = CacheIndexEntry::ReadFlagsFromBuf(mRWBuf + pos);
+    bool isDirty = flags & CacheIndexEntry::kDirtyMask;
+    bool isInitialized = flags & CacheIndexEntry::kInitializedMask;
+    bool isFileEmpty = !(flags & CacheIndexEntry::kFileSizeMask);
+    bool isFresh = flags & CacheIndexEntry::kFreshMask;
+    bool isRemoved = flags & CacheIndexEntry::kRemovedMask;
+
+    if (isDirty || !isInitialized || isFileEmpty || isFresh || isRemoved) {
       LOG(
           ("CacheIndex::ParseRecords() - Invalid entry found in index, removing"
            " whole index [dirty=%d, initialized=%d, fileEmpty=%d, fresh=%d, "
            "removed=%d]",
-           tmpEntry.IsDirty(), tmpEntry.IsInitialized(), tmpEntry.IsFileEmpty(),
-           tmpEntry.IsFresh(), tmpEntry.IsRemoved()));
+           isDirty, isInitialized, isFileEmpty, isFresh, isRemoved));
       FinishRead(false, aProofOfLock);
       return;
     }
 
-    CacheIndexEntryAutoManage emng(tmpEntry.Hash(), this, aProofOfLock);
+    const SHA1Sum::Hash* hash =
+        reinterpret_cast<const SHA1Sum::Hash*>(mRWBuf + pos);
+
+    CacheIndexEntryAutoManage emng(hash, this, aProofOfLock);
 
-    CacheIndexEntry* entry = mIndex.PutEntry(*tmpEntry.Hash());
-    *entry = tmpEntry;
+    CacheIndexEntry* entry = mIndex.PutEntry(*hash);
+    entry->ReadFromBuf(mRWBuf + pos);
 
     pos += sizeof(CacheIndexRecord);
     mSkipEntries++;
@@ -2369,11 +2377,9 @@ void CacheIndex::ParseJournal(const StaticMutexAutoLock& aProofOfLock) {
 
   while (pos + sizeof(CacheIndexRecord) <= mRWBufPos &&
          mSkipEntries != entryCnt) {
-    CacheIndexEntry tmpEntry(reinterpret_cast<SHA1Sum::Hash*>(mRWBuf + pos));
-    tmpEntry.ReadFromBuf(mRWBuf + pos);
-
-    CacheIndexEntry* entry = mTmpJournal.PutEntry(*tmpEntry.Hash());
-    *entry = tmpEntry;
+    CacheIndexEntry* entry =
+        mTmpJournal.PutEntry(*reinterpret_cast<SHA1Sum::Hash*>(mRWBuf + pos));
+    entry->ReadFromBuf(mRWBuf + pos);
 
     if (entry->IsDirty() || entry->IsFresh()) {
       LOG(
@@ -3339,7 +3345,14 @@ void CacheIndex::AllocBuffer() {
       }
       break;
     case READING:
+      // Reading is done in chunks of the buffer size, each of which is a
+      // round trip to the IO thread, so use a larger buffer than for writing,
+      // unless the index is small.
       mRWBufSize = kMaxBufSize;
+      if (mIndexHandle && mIndexHandle->FileSize() > kMaxBufSize) {
+        mRWBufSize = static_cast<uint32_t>(
+            std::min<int64_t>(mIndexHandle->FileSize(), kMaxReadBufSize));
+      }
       break;
     default:
       MOZ_ASSERT(false, "Unexpected state!");
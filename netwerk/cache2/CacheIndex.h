@@ -302,6 +302,13 @@ class CacheIndexEntry : public PLDHashEntryHdr {
         ptr, mRec->Get()->mFlags & ~(kDirtyMask | kFreshMask));
   }
 
+  // Returns the flags of a record serialized by WriteToBuf(), so that the
+  // record can be validated without creating an entry for it.
+  static uint32_t ReadFlagsFromBuf(const void* aBuf) {
+    return NetworkEndian::readUint32(static_cast<const uint8_t*>(aBuf) +
+                                     offsetof(CacheIndexRecord, mFlags));
+  }
+
   void ReadFromBuf(void* aBuf) {
     const uint8_t* ptr = static_cast<const uint8_t*>(aBuf);
     MOZ_ASSERT(memcmp(&mRec->Get()->mHash, ptr, sizeof(SHA1Sum::Hash)) == 0);
@@ -1787,27 +1787,36 @@ void nsHostResolver::ThreadFunc() {
     }
 #endif
 
-    {  // obtain lock to check shutdown and manage inter-module telemetry
-      MutexAutoLock lock(mLock);
-
-      if (!mShutdown) {
-        TimeDuration elapsed = TimeStamp::Now() - startTime;
-        if (NS_SUCCEEDED(status)) {
-          if (!rec->addr_info_gencnt) {
-            // Time for initial lookup.
-            glean::networking::dns_lookup_time.AccumulateRawDuration(elapsed);
-          } else if (!getTtl) {
-            // Time for renewal; categorized by expiration strategy.
-            glean::networking::dns_renewal_time.AccumulateRawDuration(elapsed);
-          } else {
-            // Time to get TTL; categorized by expiration strategy.
-            glean::networking::dns_renewal_time_for_ttl.AccumulateRawDuration(
-                elapsed);
-          }
+    // Record telemetry without taking mLock: mShutdown is atomic, and
+    // addr_info_gencnt is protected by the record's own lock. Every lookup
+    // thread passes through here, so avoiding the resolver-wide lock keeps it
+    // free for callers of ResolveHost while many lookups are completing.
+    MOZ_PUSH_IGNORE_THREAD_SAFETY
+    bool shutdown = mShutdown;
+    MOZ_POP_IGNORE_THREAD_SAFETY
+    if (!shutdown) {
+      int gencnt;
+      {
+        MutexAutoLock lock(rec->addr_info_lock);
+        gencnt = rec->addr_info_gencnt;
+      }
+
+      TimeDuration elapsed = TimeStamp::Now() - startTime;
+      if (NS_SUCCEEDED(status)) {
+        if (!gencnt) {
+          // Time for initial lookup.
+          glean::networking::dns_lookup_time.AccumulateRawDuration(elapsed);
+        } else if (!getTtl) {
+          // Time for renewal; categorized by expiration strategy.
+          glean::networking::dns_renewal_time.AccumulateRawDuration(elapsed);
         } else {
-          glean::networking::dns_failed_lookup_time.AccumulateRawDuration(
+          // Time to get TTL; categorized by expiration strategy.
+          glean::networking::dns_renewal_time_for_ttl.AccumulateRawDuration(
               elapsed);
         }
+      } else {
+        glean::networking::dns_failed_lookup_time.AccumulateRawDuration(
+            elapsed);
       }
     }
 
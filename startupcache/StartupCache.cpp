@@ -7,6 +7,7 @@
 #include "prio.h"
 #include "PLDHashTable.h"
 #include "mozilla/IOInterposer.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/AutoMemMap.h"
 #include "mozilla/IOBuffers.h"
 #include "mozilla/MemoryReporting.h"
@@ -43,6 +44,8 @@
 #  include <windows.h>
 #endif
 
+#include <algorithm>
+
 #ifdef IS_BIG_ENDIAN
 #  define SC_ENDIAN "big"
 #else
@@ -90,6 +93,12 @@ static const size_t STARTUP_CACHE_RESERVE_CAPACITY = 450;
 // have some bug causing runaway cache growth.
 static const size_t STARTUP_CACHE_MAX_CAPACITY = 5000;
 
+// The maximum number of background tasks that WriteToDisk will use, in
+// addition to the writing thread itself, to compress entries.
+static const size_t STARTUP_CACHE_MAX_COMPRESSION_TASKS = 4;
+// The size of the chunks fed to the LZ4 frame compressor.
+static const size_t STARTUP_CACHE_COMPRESSION_CHUNK_SIZE = 1024 * 16;
+
 // Not const because we change it for gtests.
 static uint8_t STARTUP_CACHE_WRITE_TIMEOUT = 60;
 
@@ -500,6 +509,131 @@ size_t StartupCache::HeapSizeOfIncludingThis(
   return n;
 }
 
+/**
+ * Each entry is stored as an independent LZ4 frame, so entries can be
+ * compressed concurrently and then written out in order. Entries are handed out
+ * through an atomic cursor: the thread calling Run() compresses entries
+ * alongside a few background tasks, so the write completes even if none of the
+ * background tasks get to run before the work is done.
+ *
+ * The entries must not be modified until Run() returns. WriteToDisk ensures
+ * this by holding mTableLock for the duration.
+ */
+class StartupCacheCompressor final {
+ public:
+  NS_INLINE_DECL_THREADSAFE_REFCOUNTING(StartupCacheCompressor)
+
+  explicit StartupCacheCompressor(nsTArray<StartupCacheEntry*>&& aEntries)
+      : mEntries(std::move(aEntries)),
+        mNextEntry(0),
+        mFailed(false),
+        mMonitor("StartupCacheCompressor::mMonitor"),
+        mRemaining(mEntries.Length()) {
+    mFrames.SetLength(mEntries.Length());
+  }
+
+  Result<Ok, nsresult> Run() {
+    size_t taskCount = std::min(
+        {STARTUP_CACHE_MAX_COMPRESSION_TASKS, GetNumberOfProcessors() - 1,
+         mEntries.Length() - 1});
+    for (size_t i = 0; i < taskCount; i++) {
+      RefPtr<StartupCacheCompressor> self = this;
+      nsresult rv = NS_DispatchBackgroundTask(
+          NS_NewRunnableFunction("StartupCacheCompressor::CompressEntries",
+                                 [self]() { self->CompressEntries(); }));
+      if (NS_FAILED(rv)) {
+        break;
+      }
+    }
+
+    CompressEntries();
+
+    MonitorAutoLock lock(mMonitor);
+    while (mRemaining) {
+      mMonitor.Wait();
+    }
+    if (mFailed) {
+      return Err(NS_ERROR_FAILURE);
+    }
+    return Ok();
+  }
+
+  const nsTArray<char>& Frame(size_t aIndex) const { return mFrames[aIndex]; }
+
+ private:
+  ~StartupCacheCompressor() = default;
+
+  void CompressEntries() {
+    // Avoid creating a compression context if this background task only got
+    // to run after all the work was claimed.
+    if (mNextEntry >= mEntries.Length()) {
+      return;
+    }
+
+    LZ4FrameCompressionContext ctx(6, /* aCompressionLevel */
+                                   STARTUP_CACHE_COMPRESSION_CHUNK_SIZE,
+                                   true,  /* aChecksum */
+                                   true); /* aStableSrc */
+    size_t writeBufLen = ctx.GetRequiredWriteBufferLength();
+    auto writeBuffer = MakeUnique<char[]>(writeBufLen);
+    auto writeSpan = Span(writeBuffer.get(), writeBufLen);
+
+    while (true) {
+      size_t index = mNextEntry++;
+      if (index >= mEntries.Length()) {
+        return;
+      }
+
+      if (!mFailed) {
+        auto result =
+            CompressEntry(ctx, writeSpan, *mEntries[index], mFrames[index]);
+        if (NS_WARN_IF(result.isErr())) {
+          mFailed = true;
+        }
+      }
+
+      MonitorAutoLock lock(mMonitor);
+      if (--mRemaining == 0) {
+        mMonitor.Notify();
+      }
+    }
+  }
+
+  static Result<Ok, nsresult> CompressEntry(LZ4FrameCompressionContext& aCtx,
+                                            Span<char> aWriteSpan,
+                                            const StartupCacheEntry& aEntry,
+                                            nsTArray<char>& aFrame) {
+    Span<const char> result;
+    MOZ_TRY_VAR(result,
+                aCtx.BeginCompressing(aWriteSpan).mapErr(MapLZ4ErrorToNsresult));
+    aFrame.AppendElements(result.Elements(), result.Length());
+
+    for (size_t i = 0; i < aEntry.mUncompressedSize;
+         i += STARTUP_CACHE_COMPRESSION_CHUNK_SIZE) {
+      size_t size = std::min(STARTUP_CACHE_COMPRESSION_CHUNK_SIZE,
+                             aEntry.mUncompressedSize - i);
+      const char* uncompressed = aEntry.mData.get() + i;
+      MOZ_TRY_VAR(result, aCtx.ContinueCompressing(Span(uncompressed, size))
+                              .mapErr(MapLZ4ErrorToNsresult));
+      aFrame.AppendElements(result.Elements(), result.Length());
+    }
+
+    MOZ_TRY_VAR(result, aCtx.EndCompressing().mapErr(MapLZ4ErrorToNsresult));
+    aFrame.AppendElements(result.Elements(), result.Length());
+    return Ok();
+  }
+
+  const nsTArray<StartupCacheEntry*> mEntries;
+  // Each frame is only touched by the thread that claimed its index, until
+  // Run() returns.
+  nsTArray<nsTArray<char>> mFrames;
+  Atomic<size_t> mNextEntry;
+  Atomic<bool> mFailed;
+
+  Monitor mMonitor;
+  size_t mRemaining MOZ_GUARDED_BY(mMonitor);
+};
+
 /**
  * WriteToDisk writes the cache out to disk. Callers of WriteToDisk need to call
  * WaitOnWriteComplete to make sure there isn't a write
@@ -556,40 +690,22 @@ Result<Ok, nsresult> StartupCache::WriteToDisk() {
   size_t dataStart = headerStart + buf.cursor();
   MOZ_TRY(Seek(fd, dataStart));
 
-  size_t offset = 0;
-
-  const size_t chunkSize = 1024 * 16;
-  LZ4FrameCompressionContext ctx(6,         /* aCompressionLevel */
-                                 chunkSize, /* aReadBufLen */
-                                 true,      /* aChecksum */
-                                 true);     /* aStableSrc */
-  size_t writeBufLen = ctx.GetRequiredWriteBufferLength();
-  auto writeBuffer = MakeUnique<char[]>(writeBufLen);
-  auto writeSpan = Span(writeBuffer.get(), writeBufLen);
-
+  nsTArray<StartupCacheEntry*> toCompress(entries.Length());
   for (auto& e : entries) {
-    auto value = e.second;
-    value->mOffset = offset;
-    Span<const char> result;
-    MOZ_TRY_VAR(result,
-                ctx.BeginCompressing(writeSpan).mapErr(MapLZ4ErrorToNsresult));
-    MOZ_TRY(Write(fd, result.Elements(), result.Length()));
-    offset += result.Length();
-
-    for (size_t i = 0; i < value->mUncompressedSize; i += chunkSize) {
-      size_t size = std::min(chunkSize, value->mUncompressedSize - i);
-      char* uncompressed = value->mData.get() + i;
-      MOZ_TRY_VAR(result, ctx.ContinueCompressing(Span(uncompressed, size))
-                              .mapErr(MapLZ4ErrorToNsresult));
-      MOZ_TRY(Write(fd, result.Elements(), result.Length()));
-      offset += result.Length();
-    }
+    toCompress.AppendElement(e.second);
+  }
+  RefPtr<StartupCacheCompressor> compressor =
+      new StartupCacheCompressor(std::move(toCompress));
+  MOZ_TRY(compressor->Run());
 
-    MOZ_TRY_VAR(result, ctx.EndCompressing().mapErr(MapLZ4ErrorToNsresult));
-    MOZ_TRY(Write(fd, result.Elements(), result.Length()));
-    offset += result.Length();
-    value->mCompressedSize = offset - value->mOffset;
-    MOZ_TRY(Seek(fd, dataStart + offset));
+  size_t offset = 0;
+  for (size_t i = 0; i < entries.Length(); i++) {
+    auto value = entries[i].second;
+    const nsTArray<char>& frame = compressor->Frame(i);
+    MOZ_TRY(Write(fd, frame.Elements(), frame.Length()));
+    value->mOffset = offset;
+    value->mCompressedSize = frame.Length();
+    offset += frame.Length();
   }
 
   for (auto& e : entries) {
@@ -267,6 +267,11 @@ void PLDHashTable::Hash2(PLDHashNumber aHash0, uint32_t& aHash2Out,
 // flag in addition to the removed-entry sentinel value. Multiplicative hash
 // uses the high order bits of mKeyHash, so this least-significant reservation
 // should not hurt the hash function's effectiveness much.
+//
+// Every slot that an entry's probe sequence passed over before reaching that
+// entry has the collision flag set (removing such a slot leaves a sentinel,
+// which also has it set). So a lookup that reaches a live slot without the
+// flag can stop: no entry lies further along its probe sequence.
 
 // Match an entry's mKeyHash against an unstored one computed from a key.
 /* static */
@@ -343,6 +348,11 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
     }
   }
 
+  // Miss: nothing was ever added past this slot.
+  if (Reason != ForAdd && !slot.IsColliding()) {
+    return aFailure();
+  }
+
   // Collision: double hash.
   PLDHashNumber hash2;
   uint32_t sizeMask;
@@ -378,6 +388,10 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
         return aSuccess(slot);
       }
     }
+
+    if (Reason != ForAdd && !slot.IsColliding()) {
+      return aFailure();
+    }
   }
 
   // NOTREACHED
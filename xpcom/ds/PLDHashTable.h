@@ -234,6 +234,7 @@ class PLDHashTable {
     bool IsFree() const { return KeyHash() == 0; }
     bool IsRemoved() const { return KeyHash() == 1; }
     bool IsLive() const { return IsLiveHash(KeyHash()); }
+    bool IsColliding() const { return KeyHash() & kCollisionFlag; }
     static bool IsLiveHash(uint32_t aHash) { return aHash >= 2; }
 
     void MarkFree() { *HashPtr() = 0; }
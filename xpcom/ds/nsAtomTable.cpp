@@ -9,8 +9,8 @@
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/MruCache.h"
-#include "mozilla/Mutex.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/RWLock.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/TextUtils.h"
 #include "mozilla/Unused.h"
@@ -40,7 +40,9 @@
 //   immutable, so it ignores all AddRef/Release calls.
 //
 // Note that gAtomTable is used on multiple threads, and has internal
-// synchronization.
+// synchronization. Looking up an atom that is already in the table only takes
+// a subtable's lock for reading, so concurrent atomization of existing atoms
+// doesn't serialize; the lock is taken for writing to insert atoms or GC.
 
 using namespace mozilla;
 
@@ -184,24 +186,41 @@ static AtomCache sRecentlyUsedMainThreadAtoms;
 //
 // NB: This is somewhat similar to the technique used by Java's
 // ConcurrentHashTable.
+//
+// Most atomizations are of atoms that already exist, so each subtable is
+// guarded by a reader-writer lock: lookups only take it for reading and can
+// proceed in parallel, and it is only taken for writing to add atoms or to GC.
 class nsAtomSubTable {
   friend class nsAtomTable;
-  Mutex mLock;
+  RWLock mLock;
   PLDHashTable mTable;
   nsAtomSubTable();
   void GCLocked(GCKind aKind) MOZ_REQUIRES(mLock);
   void AddSizeOfExcludingThisLocked(MallocSizeOf aMallocSizeOf,
                                     AtomsSizes& aSizes) MOZ_REQUIRES(mLock);
 
-  AtomTableEntry* Search(AtomTableKey& aKey) const MOZ_REQUIRES(mLock) {
-    mLock.AssertCurrentThreadOwns();
+  AtomTableEntry* Search(AtomTableKey& aKey) const MOZ_REQUIRES_SHARED(mLock) {
     return static_cast<AtomTableEntry*>(mTable.Search(&aKey));
   }
 
   AtomTableEntry* Add(AtomTableKey& aKey) MOZ_REQUIRES(mLock) {
-    mLock.AssertCurrentThreadOwns();
+    MOZ_ASSERT(mLock.LockedForWritingByCurrentThread());
     return static_cast<AtomTableEntry*>(mTable.Add(&aKey));  // Infallible
   }
+
+  // Returns the existing atom for aKey, if any, taking mLock only for reading.
+  // Atoms can only be removed by GC, which takes mLock for writing, so it is
+  // safe to resurrect an atom with a zero refcount here.
+  already_AddRefed<nsAtom> LookupShared(AtomTableKey& aKey)
+      MOZ_EXCLUDES(mLock) {
+    AutoReadLock lock(mLock);
+    AtomTableEntry* he = Search(aKey);
+    if (!he) {
+      return nullptr;
+    }
+    RefPtr<nsAtom> atom = he->mAtom;
+    return atom.forget();
+  }
 };
 
 // The outer atom table, which coordinates access to the inner array of
@@ -344,7 +363,7 @@ void nsAtomTable::AddSizeOfIncludingThis(MallocSizeOf aMallocSizeOf,
   MOZ_ASSERT(NS_IsMainThread());
   aSizes.mTable += aMallocSizeOf(this);
   for (auto& table : mSubTables) {
-    MutexAutoLock lock(table.mLock);
+    AutoWriteLock lock(table.mLock);
     table.AddSizeOfExcludingThisLocked(aMallocSizeOf, aSizes);
   }
 }
@@ -356,7 +375,7 @@ void nsAtomTable::GC(GCKind aKind) {
   // Note that this is effectively an incremental GC, since only one subtable
   // is locked at a time.
   for (auto& table : mSubTables) {
-    MutexAutoLock lock(table.mLock);
+    AutoWriteLock lock(table.mLock);
     table.GCLocked(aKind);
   }
 
@@ -376,9 +395,9 @@ void nsAtomTable::GC(GCKind aKind) {
   // shutdown.
   //
   // Note that, barring refcounting bugs, an atom can only go from a zero
-  // refcount to a non-zero refcount while the atom table lock is held, so
-  // so we won't try to resurrect a zero refcount atom while trying to delete
-  // it.
+  // refcount to a non-zero refcount while the atom table lock is held (for
+  // reading or writing), and GC holds it for writing, so we won't try to
+  // resurrect a zero refcount atom while trying to delete it.
 
   MOZ_ASSERT_IF(aKind == GCKind::Shutdown,
                 nsDynamicAtom::gUnusedAtomCount == 0);
@@ -389,7 +408,7 @@ size_t nsAtomTable::RacySlowCount() {
   GC(GCKind::RegularOperation);
   size_t count = 0;
   for (auto& table : mSubTables) {
-    MutexAutoLock lock(table.mLock);
+    AutoReadLock lock(table.mLock);
     count += table.mTable.EntryCount();
   }
 
@@ -402,7 +421,7 @@ nsAtomSubTable::nsAtomSubTable()
 
 void nsAtomSubTable::GCLocked(GCKind aKind) {
   MOZ_ASSERT(NS_IsMainThread());
-  mLock.AssertCurrentThreadOwns();
+  MOZ_ASSERT(mLock.LockedForWritingByCurrentThread());
 
   int32_t removedCount = 0;  // A non-atomic temporary for cheaper increments.
   nsAutoCString nonZeroRefcountAtoms;
@@ -491,7 +510,7 @@ void NS_AddSizeOfAtoms(MallocSizeOf aMallocSizeOf, AtomsSizes& aSizes) {
 
 void nsAtomSubTable::AddSizeOfExcludingThisLocked(MallocSizeOf aMallocSizeOf,
                                                   AtomsSizes& aSizes) {
-  mLock.AssertCurrentThreadOwns();
+  MOZ_ASSERT(mLock.LockedForWritingByCurrentThread());
   aSizes.mTable += mTable.ShallowSizeOfExcludingThis(aMallocSizeOf);
   for (auto iter = mTable.Iter(); !iter.Done(); iter.Next()) {
     auto entry = static_cast<AtomTableEntry*>(iter.Get());
@@ -518,7 +537,7 @@ void nsAtomTable::RegisterStaticAtoms(const nsStaticAtom* aAtoms,
 
     AtomTableKey key(atom);
     nsAtomSubTable& table = SelectSubTable(key);
-    MutexAutoLock lock(table.mLock);
+    AutoWriteLock lock(table.mLock);
     AtomTableEntry* he = table.Add(key);
 
     if (he->mAtom) {
@@ -553,7 +572,11 @@ already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsACString& aUTF8String) {
     return Atomize(str);
   }
   nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
+  if (RefPtr<nsAtom> atom = table.LookupShared(key)) {
+    return atom.forget();
+  }
+
+  AutoWriteLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
 
   if (he->mAtom) {
@@ -583,7 +606,11 @@ already_AddRefed<nsAtom> NS_Atomize(const char16_t* aUTF16String) {
 already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
   nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
+  if (RefPtr<nsAtom> atom = table.LookupShared(key)) {
+    return atom.forget();
+  }
+
+  AutoWriteLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
 
   if (he->mAtom) {
@@ -615,7 +642,13 @@ already_AddRefed<nsAtom> nsAtomTable::AtomizeMainThread(
   }
 
   nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
+  retVal = table.LookupShared(key);
+  if (retVal) {
+    p.Set(retVal);
+    return retVal.forget();
+  }
+
+  AutoWriteLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
 
   if (he->mAtom) {
@@ -652,7 +685,7 @@ nsStaticAtom* NS_GetStaticAtom(const nsAString& aUTF16String) {
 nsStaticAtom* nsAtomTable::GetStaticAtom(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
   nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
+  AutoReadLock lock(table.mLock);
   AtomTableEntry* he = table.Search(key);
   return he && he->mAtom->IsStatic() ? static_cast<nsStaticAtom*>(he->mAtom)
                                      : nullptr;
@@ -7,12 +7,15 @@
 #include "mozilla/ArrayUtils.h"
 
 #include "nsAtom.h"
+#include "nsPrintfCString.h"
 #include "nsString.h"
+#include "nsTArray.h"
 #include "UTFStrings.h"
 #include "nsIThread.h"
 #include "nsThreadUtils.h"
 
 #include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
 #include "mozilla/gtest/MozAssertions.h"
 
 using namespace mozilla;
@@ -174,4 +177,50 @@ TEST(Atoms, ConcurrentAccessing)
   EXPECT_EQ(NS_GetUnusedAtomCount(), int32_t(1));
 }
 
+static const size_t kBenchAtomCount = 256;
+static const size_t kBenchIterations = 200;
+
+static void AtomizeExistingAtoms(void* aStrings) {
+  auto* strings = static_cast<const nsTArray<nsString>*>(aStrings);
+  for (size_t i = 0; i < kBenchIterations; i++) {
+    for (const nsString& string : *strings) {
+      RefPtr<nsAtom> atom = NS_Atomize(string);
+    }
+  }
+}
+
+// Measures the throughput of atomizing strings whose atoms already exist, which
+// is the common case, from aThreadCount threads at once.
+static void BenchAtomizeExisting(size_t aThreadCount) {
+  nsTArray<nsString> strings(kBenchAtomCount);
+  nsTArray<RefPtr<nsAtom>> atoms(kBenchAtomCount);
+  for (size_t i = 0; i < kBenchAtomCount; i++) {
+    nsString* string = strings.AppendElement();
+    CopyASCIItoUTF16(nsPrintfCString("bench-atom-%zu", i), *string);
+    atoms.AppendElement(NS_Atomize(*string));
+  }
+
+  nsTArray<PRThread*> threads(aThreadCount);
+  for (size_t i = 0; i < aThreadCount; i++) {
+    PRThread* thread = PR_CreateThread(
+        PR_USER_THREAD, AtomizeExistingAtoms, &strings, PR_PRIORITY_NORMAL,
+        PR_GLOBAL_THREAD, PR_JOINABLE_THREAD, 0);
+    ASSERT_TRUE(thread);
+    threads.AppendElement(thread);
+  }
+
+  for (PRThread* thread : threads) {
+    EXPECT_EQ(PR_SUCCESS, PR_JoinThread(thread));
+  }
+}
+
+MOZ_GTEST_BENCH(Atoms, PerfAtomizeExisting1Thread,
+                [] { BenchAtomizeExisting(1); });
+
+MOZ_GTEST_BENCH(Atoms, PerfAtomizeExisting4Threads,
+                [] { BenchAtomizeExisting(4); });
+
+MOZ_GTEST_BENCH(Atoms, PerfAtomizeExisting16Threads,
+                [] { BenchAtomizeExisting(16); });
+
 }  // namespace TestAtoms
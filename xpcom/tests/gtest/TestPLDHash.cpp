@@ -6,6 +6,7 @@
 
 #include "PLDHashTable.h"
 #include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
 #include "mozilla/gtest/MozHelpers.h"
 
 // This test mostly focuses on edge cases. But more coverage of normal
@@ -372,6 +373,85 @@ TEST(PLDHashTableTest, WithEntryHandle)
   ASSERT_EQ(entry1, entry2);
 }
 
+static PLDHashNumber CollidingHash(const void* key) {
+  // Map many keys to the same hash so that probe sequences overlap.
+  return (PLDHashNumber)((size_t)key % 7);
+}
+
+static const PLDHashTableOps collidingOps = {
+    CollidingHash, PLDHashTable::MatchEntryStub, PLDHashTable::MoveEntryStub,
+    PLDHashTable::ClearEntryStub, TrivialInitEntry};
+
+TEST(PLDHashTableTest, SearchWithCollisionsAndRemovals)
+{
+  PLDHashTable t(&collidingOps, sizeof(PLDHashEntryStub));
+
+  // Add keys 1..256, remove every third one, and re-add some of those, so
+  // that lookups have to walk past both live entries and removed-entry
+  // sentinels.
+  for (size_t i = 1; i <= 256; i++) {
+    t.Add((const void*)i);
+  }
+  for (size_t i = 3; i <= 256; i += 3) {
+    t.Remove((const void*)i);
+  }
+  for (size_t i = 3; i <= 256; i += 9) {
+    t.Add((const void*)i);
+  }
+
+  for (size_t i = 1; i <= 512; i++) {
+    bool expected = i <= 256 && (i % 3 != 0 || i % 9 == 3);
+    ASSERT_EQ(!!t.Search((const void*)i), expected);
+  }
+}
+
+static const uint32_t kBenchKeyCount = 50000;
+
+static void BenchAdd() {
+  PLDHashTable t(&trivialOps, sizeof(PLDHashEntryStub));
+  for (size_t i = 1; i <= kBenchKeyCount; i++) {
+    t.Add((const void*)(i * 2654435761u));
+  }
+  ASSERT_EQ(t.EntryCount(), kBenchKeyCount);
+}
+
+static void BenchSearch(bool aHit) {
+  PLDHashTable t(&trivialOps, sizeof(PLDHashEntryStub));
+  for (size_t i = 1; i <= kBenchKeyCount; i++) {
+    t.Add((const void*)(i * 2));
+  }
+
+  uint32_t found = 0;
+  for (uint32_t j = 0; j < 10; j++) {
+    for (size_t i = 1; i <= kBenchKeyCount; i++) {
+      if (t.Search((const void*)(aHit ? i * 2 : i * 2 + 1))) {
+        found++;
+      }
+    }
+  }
+  ASSERT_EQ(found, aHit ? kBenchKeyCount * 10 : 0);
+}
+
+static void BenchIterate() {
+  PLDHashTable t(&trivialOps, sizeof(PLDHashEntryStub));
+  for (size_t i = 1; i <= kBenchKeyCount; i++) {
+    t.Add((const void*)i);
+  }
+
+  size_t sum = 0;
+  for (uint32_t j = 0; j < 10; j++) {
+    for (auto iter = t.Iter(); !iter.Done(); iter.Next()) {
+      sum += (size_t) static_cast<PLDHashEntryStub*>(iter.Get())->key;
+    }
+  }
+  ASSERT_EQ(sum, size_t(kBenchKeyCount) * (kBenchKeyCount + 1) / 2 * 10);
+}
+
+MOZ_GTEST_BENCH(PLDHashTableTest, PerfAdd, BenchAdd);
+MOZ_GTEST_BENCH(PLDHashTableTest, PerfSearchHit, [] { BenchSearch(true); });
+MOZ_GTEST_BENCH(PLDHashTableTest, PerfSearchMiss, [] { BenchSearch(false); });
+MOZ_GTEST_BENCH(PLDHashTableTest, PerfIterate, BenchIterate);
+
 // This test involves resizing a table repeatedly up to 512 MiB in size. On
 // 32-bit platforms (Win32, Android) it sometimes OOMs, causing the test to
 // fail. (See bug 931062 and bug 1267227.) Therefore, we only run it on 64-bit
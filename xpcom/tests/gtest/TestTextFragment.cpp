@@ -0,0 +1,172 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+#include "mozilla/TextUtils.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsTextFragment.h"
+
+// nsTextFragment's SIMD kernels handle whole vectors and then a scalar tail,
+// so check lengths on either side of each vector size.
+static const uint32_t kMaxTestLength = 100;
+
+static void Check1b(const nsString& aText) {
+  nsTextFragment frag;
+  ASSERT_TRUE(frag.SetTo(aText, false, false));
+  ASSERT_FALSE(frag.Is2b());
+
+  const char16_t* begin = aText.BeginReading();
+  const char16_t* end = aText.EndReading();
+  EXPECT_EQ(frag.Is1bOnlyWhitespace(),
+            std::all_of(begin, end, mozilla::IsAsciiWhitespace<char16_t>));
+  EXPECT_EQ(frag.CountNewlines(), uint32_t(std::count(begin, end, u'\n')));
+}
+
+TEST(TextFragment, IsOnlyWhitespace)
+{
+  for (uint32_t length = 2; length < kMaxTestLength; length++) {
+    nsString text;
+    for (uint32_t i = 0; i < length; i++) {
+      text.Append(u" \t\n\r\f"[i % 5]);
+    }
+    Check1b(text);
+
+    // A non-space character (including the ones next to the ASCII whitespace
+    // range) at each position.
+    for (uint32_t i = 0; i < length; i++) {
+      for (char16_t ch : {u'x', u'\v', u'\x1f', u'!', u'\xa0'}) {
+        nsString copy(text);
+        copy.SetCharAt(ch, i);
+        Check1b(copy);
+      }
+    }
+  }
+}
+
+TEST(TextFragment, CountNewlines)
+{
+  for (uint32_t length = 2; length < kMaxTestLength; length++) {
+    nsString text;
+    for (uint32_t i = 0; i < length; i++) {
+      text.Append(i % 3 == 0 ? u'\n' : u'a');
+    }
+    Check1b(text);
+
+    nsTextFragment frag;
+    ASSERT_TRUE(frag.SetTo(text, false, /* aForce2b */ true));
+    ASSERT_TRUE(frag.Is2b());
+    EXPECT_EQ(frag.CountNewlines(), (length + 2) / 3);
+
+    // The length-limited overload only counts a prefix, and clamps to the
+    // fragment's length.
+    nsTextFragment frag1b;
+    ASSERT_TRUE(frag1b.SetTo(text, false, false));
+    for (uint32_t prefix : {0u, length / 2, length, UINT32_MAX}) {
+      uint32_t expected = (std::min(prefix, length) + 2) / 3;
+      EXPECT_EQ(frag1b.CountNewlines(prefix), expected);
+      EXPECT_EQ(frag.CountNewlines(prefix), expected);
+    }
+  }
+}
+
+// A document's worth of text node contents: mostly inter-element whitespace
+// and short runs of text, with some longer paragraphs and some non-Latin-1
+// text.
+static void MakeTextNodes(nsTArray<nsString>& aNodes) {
+  for (uint32_t i = 0; i < 20000; i++) {
+    nsString text;
+    switch (i % 8) {
+      case 0:
+      case 1:
+      case 2:
+        text.AssignLiteral(u"\n  ");
+        for (uint32_t j = 0; j < i % 12; j++) {
+          text.Append(u' ');
+        }
+        break;
+      case 3:
+        text.AssignLiteral(u"Home");
+        break;
+      case 4:
+        text.AssignLiteral(u"\n");
+        for (uint32_t j = 0; j < 28; j++) {
+          text.Append(u'\t');
+        }
+        break;
+      case 5:
+      case 6:
+        for (uint32_t j = 0; j < 8; j++) {
+          text.AppendLiteral(
+              u"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed "
+              u"do eiusmod tempor incididunt ut labore et dolore magna.\n");
+        }
+        break;
+      case 7:
+        text.AssignLiteral(u"日本語のテキスト ");
+        text.AppendInt(i);
+        break;
+    }
+    aNodes.AppendElement(std::move(text));
+  }
+}
+
+static void BenchSetTo() {
+  nsTArray<nsString> nodes;
+  MakeTextNodes(nodes);
+
+  for (uint32_t j = 0; j < 10; j++) {
+    for (const nsString& text : nodes) {
+      nsTextFragment frag;
+      ASSERT_TRUE(frag.SetTo(text, false, false));
+    }
+  }
+}
+
+static void BenchIsOnlyWhitespace() {
+  nsTArray<nsString> nodes;
+  MakeTextNodes(nodes);
+
+  nsTArray<nsTextFragment> frags(nodes.Length());
+  for (const nsString& text : nodes) {
+    ASSERT_TRUE(frags.AppendElement()->SetTo(text, false, false));
+  }
+
+  uint32_t whitespace = 0;
+  for (uint32_t j = 0; j < 100; j++) {
+    for (const nsTextFragment& frag : frags) {
+      if (!frag.Is2b() && frag.Is1bOnlyWhitespace()) {
+        whitespace++;
+      }
+    }
+  }
+  ASSERT_EQ(whitespace, 100u * 20000 / 2);
+}
+
+static void BenchCountNewlines() {
+  nsTArray<nsString> nodes;
+  MakeTextNodes(nodes);
+
+  nsTArray<nsTextFragment> frags(nodes.Length());
+  for (const nsString& text : nodes) {
+    ASSERT_TRUE(frags.AppendElement()->SetTo(text, false, false));
+  }
+
+  uint32_t newlines = 0;
+  for (uint32_t j = 0; j < 100; j++) {
+    for (const nsTextFragment& frag : frags) {
+      newlines += frag.CountNewlines();
+    }
+  }
+  ASSERT_EQ(newlines, 100u * (20000 / 8) * (3 + 1 + 2 * 8));
+}
+
+MOZ_GTEST_BENCH(TextFragment, PerfSetTo, BenchSetTo);
+MOZ_GTEST_BENCH(TextFragment, PerfIsOnlyWhitespace, BenchIsOnlyWhitespace);
+MOZ_GTEST_BENCH(TextFragment, PerfCountNewlines, BenchCountNewlines);
@@ -612,10 +612,34 @@ size_t TimerThread::ComputeTimerInsertionIndex(const TimeStamp& timeout) const {
 
   const size_t timerCount = mTimers.Length();
 
-  size_t firstGtIndex = 0;
-  while (firstGtIndex < timerCount &&
-         (!mTimers[firstGtIndex].Value() ||
-          mTimers[firstGtIndex].Timeout() <= timeout)) {
+  // Binary search for the boundary between the non-canceled timers that fire
+  // at or before `timeout` and those that fire after it. Non-canceled timers
+  // are sorted, but canceled entries may hold any timeout, so each probe skips
+  // forward to the next non-canceled entry.
+  // Invariant: non-canceled entries in [0, low) have Timeout() <= timeout, and
+  // non-canceled entries in [high, timerCount) have Timeout() > timeout.
+  size_t low = 0;
+  size_t high = timerCount;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    size_t probe = middle;
+    while (probe < high && !mTimers[probe].Value()) {
+      ++probe;
+    }
+    if (probe == high) {
+      // Everything in [middle, high) is canceled.
+      high = middle;
+    } else if (mTimers[probe].Timeout() <= timeout) {
+      low = probe + 1;
+    } else {
+      high = probe;
+    }
+  }
+
+  // Return the first non-canceled timer after the boundary, so that any
+  // canceled entries just before it can be reused by the caller.
+  size_t firstGtIndex = low;
+  while (firstGtIndex < timerCount && !mTimers[firstGtIndex].Value()) {
     ++firstGtIndex;
   }
 
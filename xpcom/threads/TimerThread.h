@@ -181,7 +181,8 @@ class TimerThread final : public mozilla::Runnable, public nsIObserver {
   // mTimers is maintained in a "pseudo-sorted" order wrt the timeouts.
   // Specifcally, mTimers is sorted according to the timeouts *if you ignore the
   // canceled entries* (those whose mTimerImpl is nullptr). Notably this means
-  // that you cannot use a binary search on this list.
+  // that a plain binary search cannot be used on this list; see
+  // ComputeTimerInsertionIndex() for one that skips over canceled entries.
   nsTArray<Entry> mTimers MOZ_GUARDED_BY(mMonitor);
 
   // Set only at the start of the thread's Run():